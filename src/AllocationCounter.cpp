@@ -0,0 +1,42 @@
+/*
+ * Museum Escape - Allocation Counter Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "AllocationCounter.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local std::uint64_t allocations = 0; // Trivial type: safe during thread teardown
+}
+
+std::uint64_t AllocationCounter::getCount() { return allocations; }
+bool AllocationCounter::isEnabled() { return PROFILER_ENABLED != 0; }
+
+bool AllocationCounter::countsLibraries() {
+#if defined(_WIN32) && !defined(SFML_STATIC)
+    return false;
+#else
+    return true;
+#endif
+}
+
+#if PROFILER_ENABLED
+// The library's array and nothrow forms forward to these (over-aligned
+// allocations are not counted)
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
@@ -0,0 +1,24 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// AllocationCounter - Heap allocations made by the calling thread, counted
+// by replacing the global operator new. Only in profiling builds (see
+// Profiler.h); in release builds the counter stays at zero and isEnabled()
+// is false. Take the difference of two getCount() calls to count the
+// allocations a piece of code made.
+//
+// On Windows each DLL resolves operator new against its own C runtime, so
+// with SFML linked as DLLs (no SFML_STATIC) only the game's own allocations
+// are counted: whatever SFML allocates inside its DLLs is missed, and
+// countsLibraries() is false so the overlay can say so. Link SFML
+// statically to count everything.
+class AllocationCounter {
+public:
+    static std::uint64_t getCount();
+    static bool isEnabled();
+    static bool countsLibraries(); // SFML's own allocations included
+};
+
+#endif // ALLOCATION_COUNTER_H
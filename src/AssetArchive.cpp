@@ -0,0 +1,204 @@
+/*
+ * Museum Escape - Asset Archive Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "AssetArchive.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char MAGIC[4] = {'M', 'E', 'P', 'K'};
+    const std::uint16_t VERSION = 1;
+    const std::size_t HEADER_SIZE = 16;
+    const std::size_t TOC_ENTRY_SIZE = 24;
+    const char* const ARCHIVE_EXTENSION = ".pak";
+
+    void putFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+
+    std::uint64_t getFixed(const std::uint8_t* in, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+const char* const AssetArchive::DEFAULT_PATH = "assets/assets.pak";
+
+AssetArchive::AssetArchive() {}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+
+    const std::uint8_t* data = file.getData();
+    std::size_t size = file.getSize();
+    if (size < HEADER_SIZE || !std::equal(MAGIC, MAGIC + 4, data) || getFixed(data + 4, 2) != VERSION) {
+        std::cerr << "Error: " << path << " is not an asset archive" << std::endl;
+        close();
+        return false;
+    }
+
+    std::size_t count = static_cast<std::size_t>(getFixed(data + 8, 4));
+    std::size_t namesSize = static_cast<std::size_t>(getFixed(data + 12, 4));
+    std::size_t namesStart = HEADER_SIZE + count * TOC_ENTRY_SIZE;
+    if (namesStart + namesSize > size) {
+        std::cerr << "Error: " << path << " has a truncated table of contents" << std::endl;
+        close();
+        return false;
+    }
+
+    const char* names = reinterpret_cast<const char*>(data + namesStart);
+    entries.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const std::uint8_t* toc = data + HEADER_SIZE + i * TOC_ENTRY_SIZE;
+        std::uint64_t offset = getFixed(toc, 8);
+        std::uint64_t length = getFixed(toc + 8, 8);
+        std::uint64_t nameOffset = getFixed(toc + 16, 4);
+        std::uint64_t nameLength = getFixed(toc + 20, 4);
+        if (offset > size || length > size - offset || nameOffset + nameLength > namesSize) {
+            std::cerr << "Error: " << path << " entry " << i << " is out of range" << std::endl;
+            close();
+            return false;
+        }
+        Span span;
+        span.data = data + offset;
+        span.size = static_cast<std::size_t>(length);
+        entries[std::string(names + nameOffset, static_cast<std::size_t>(nameLength))] = span;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    entries.clear();
+    file.close();
+}
+
+bool AssetArchive::isOpen() const { return file.isOpen(); }
+
+bool AssetArchive::contains(const std::string& name) const {
+    return entries.find(name) != entries.end();
+}
+
+AssetArchive::Span AssetArchive::find(const std::string& name) const {
+    auto it = entries.find(name);
+    return it != entries.end() ? it->second : Span();
+}
+
+std::optional<sf::MemoryInputStream> AssetArchive::stream(const std::string& name) const {
+    Span span = find(name);
+    if (!span.data) return std::nullopt;
+    return sf::MemoryInputStream(span.data, span.size);
+}
+
+std::size_t AssetArchive::getEntryCount() const { return entries.size(); }
+
+std::vector<std::string> AssetArchive::getEntryNames() const {
+    std::vector<std::string> names;
+    names.reserve(entries.size());
+    for (const auto& pair : entries) names.push_back(pair.first);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool AssetArchive::load(sf::Font& font, const std::string& name) const {
+    Span span = find(name);
+    return span.data ? font.openFromMemory(span.data, span.size) : font.openFromFile(name);
+}
+
+bool AssetArchive::load(sf::Texture& texture, const std::string& name) const {
+    Span span = find(name);
+    return span.data ? texture.loadFromMemory(span.data, span.size) : texture.loadFromFile(name);
+}
+
+bool AssetArchive::load(sf::Image& image, const std::string& name) const {
+    Span span = find(name);
+    return span.data ? image.loadFromMemory(span.data, span.size) : image.loadFromFile(name);
+}
+
+bool AssetArchive::load(sf::SoundBuffer& buffer, const std::string& name) const {
+    Span span = find(name);
+    return span.data ? buffer.loadFromMemory(span.data, span.size) : buffer.loadFromFile(name);
+}
+
+// ===================================
+// Packing
+// ===================================
+
+bool AssetArchive::pack(const std::string& assetsDir, const std::string& outPath) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (!fs::is_directory(assetsDir, error)) {
+        std::cerr << "Error: " << assetsDir << " is not a directory" << std::endl;
+        return false;
+    }
+
+    // Sorted so the same tree always packs to the same bytes
+    std::vector<fs::path> files;
+    for (fs::recursive_directory_iterator it(assetsDir, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) continue;
+        if (it->path().extension() == ARCHIVE_EXTENSION) continue;
+        if (fs::equivalent(it->path(), outPath, error)) continue;
+        files.push_back(it->path());
+    }
+    if (error) {
+        std::cerr << "Error: Could not list " << assetsDir << ": " << error.message() << std::endl;
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> names;
+    std::vector<std::uint8_t> namesBlob;
+    for (const fs::path& path : files) {
+        std::string name = (fs::path(assetsDir) / path.lexically_relative(assetsDir)).lexically_normal().generic_string();
+        names.push_back(name);
+        namesBlob.insert(namesBlob.end(), name.begin(), name.end());
+    }
+
+    std::vector<std::uint8_t> out;
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    putFixed(out, VERSION, 2);
+    putFixed(out, 0, 2);
+    putFixed(out, files.size(), 4);
+    putFixed(out, namesBlob.size(), 4);
+
+    std::size_t dataStart = alignUp(HEADER_SIZE + files.size() * TOC_ENTRY_SIZE + namesBlob.size(), DATA_ALIGNMENT);
+    std::vector<std::uint8_t> data;
+    std::size_t nameOffset = 0;
+    for (std::size_t i = 0; i < files.size(); i++) {
+        std::ifstream in(files[i], std::ios::binary);
+        if (!in) {
+            std::cerr << "Error: Could not read " << files[i].string() << std::endl;
+            return false;
+        }
+        std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        data.resize(alignUp(data.size(), DATA_ALIGNMENT), 0);
+        putFixed(out, dataStart + data.size(), 8);
+        putFixed(out, bytes.size(), 8);
+        putFixed(out, nameOffset, 4);
+        putFixed(out, names[i].size(), 4);
+        data.insert(data.end(), bytes.begin(), bytes.end());
+        nameOffset += names[i].size();
+    }
+    out.insert(out.end(), namesBlob.begin(), namesBlob.end());
+    out.resize(dataStart, 0);
+    out.insert(out.end(), data.begin(), data.end());
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+        std::cerr << "Error: Could not write " << outPath << std::endl;
+        return false;
+    }
+    std::cout << "Packed " << files.size() << " assets (" << out.size() << " bytes) into " << outPath << std::endl;
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MappedFile.h"
+
+// AssetArchive - Every asset in one packed file, memory-mapped once at
+// startup. A table of contents maps each asset's loose path (e.g.
+// "assets/arial.ttf") to its bytes inside the mapping; SFML decodes
+// straight from there, so there are no per-asset opens or copies.
+//
+// Layout (little-endian):
+//     header   "MEPK", u16 version, u16 flags, u32 entryCount, u32 namesSize
+//     TOC      entryCount x {u64 offset, u64 size, u32 nameOffset, u32 nameLength}
+//     names    namesSize bytes, not terminated
+//     data     each entry aligned to DATA_ALIGNMENT
+//
+// The load() overloads fall back to the loose file when the archive is not
+// open or has no such entry, so callers never need two code paths.
+class AssetArchive {
+public:
+    static const std::size_t DATA_ALIGNMENT = 16;
+    static const char* const DEFAULT_PATH; // What the game opens at startup
+
+    struct Span {
+        const std::uint8_t* data = nullptr;
+        std::size_t size = 0;
+    };
+
+private:
+    MappedFile file;
+    std::unordered_map<std::string, Span> entries;
+
+public:
+    // Constructor
+    AssetArchive();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    bool contains(const std::string& name) const;
+    // Bytes of an entry (null data when absent); valid while the archive is open
+    Span find(const std::string& name) const;
+    // A stream over an entry for SFML's loadFromStream/openFromStream
+    std::optional<sf::MemoryInputStream> stream(const std::string& name) const;
+    std::size_t getEntryCount() const;
+    std::vector<std::string> getEntryNames() const; // Sorted
+
+    // Load from the archive, else from the loose file of the same name.
+    // A font (like music) keeps reading its source, so it must not outlive
+    // the archive.
+    bool load(sf::Font& font, const std::string& name) const;
+    bool load(sf::Texture& texture, const std::string& name) const;
+    bool load(sf::Image& image, const std::string& name) const;
+    bool load(sf::SoundBuffer& buffer, const std::string& name) const;
+
+    // Pack every file under assetsDir, named by its loose path (assetsDir
+    // joined with the relative path), into outPath. Used by tools/PackAssets.
+    static bool pack(const std::string& assetsDir, const std::string& outPath);
+};
+
+#endif // ASSET_ARCHIVE_H
@@ -0,0 +1,111 @@
+/*
+ * Museum Escape - AssetCooker Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "AssetCooker.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+sf::Image AssetCooker::downsample(const sf::Image& source, sf::Vector2u targetSize) {
+    sf::Vector2u sourceSize = source.getSize();
+    sf::Image result;
+    if (sourceSize.x == 0 || sourceSize.y == 0 || targetSize.x == 0 || targetSize.y == 0) return result;
+    result.resize(targetSize);
+
+    const std::uint8_t* pixels = source.getPixelsPtr();
+    float scaleX = static_cast<float>(sourceSize.x) / targetSize.x;
+    float scaleY = static_cast<float>(sourceSize.y) / targetSize.y;
+
+    for (unsigned int ty = 0; ty < targetSize.y; ++ty) {
+        float y0 = ty * scaleY;
+        float y1 = y0 + scaleY;
+        for (unsigned int tx = 0; tx < targetSize.x; ++tx) {
+            float x0 = tx * scaleX;
+            float x1 = x0 + scaleX;
+
+            // Weight each source pixel by how much of it the footprint covers
+            double r = 0, g = 0, b = 0, a = 0, total = 0;
+            for (unsigned int sy = static_cast<unsigned int>(y0); sy < std::min<float>(std::ceil(y1), sourceSize.y); ++sy) {
+                float wy = std::min<float>(y1, sy + 1.0f) - std::max<float>(y0, static_cast<float>(sy));
+                for (unsigned int sx = static_cast<unsigned int>(x0); sx < std::min<float>(std::ceil(x1), sourceSize.x); ++sx) {
+                    float wx = std::min<float>(x1, sx + 1.0f) - std::max<float>(x0, static_cast<float>(sx));
+                    float w = wx * wy;
+                    const std::uint8_t* p = pixels + (static_cast<std::size_t>(sy) * sourceSize.x + sx) * 4;
+                    float alpha = p[3] / 255.0f;
+                    r += p[0] * alpha * w;
+                    g += p[1] * alpha * w;
+                    b += p[2] * alpha * w;
+                    a += p[3] * w;
+                    total += w;
+                }
+            }
+
+            sf::Color color = sf::Color::Transparent;
+            if (total > 0 && a > 0) {
+                double coverage = a / 255.0;
+                color.r = static_cast<std::uint8_t>(std::min(255.0, r / coverage + 0.5));
+                color.g = static_cast<std::uint8_t>(std::min(255.0, g / coverage + 0.5));
+                color.b = static_cast<std::uint8_t>(std::min(255.0, b / coverage + 0.5));
+                color.a = static_cast<std::uint8_t>(std::min(255.0, a / total + 0.5));
+            }
+            result.setPixel({tx, ty}, color);
+        }
+    }
+    return result;
+}
+
+sf::Vector2u AssetCooker::cookedCharacterSize() {
+    return {static_cast<unsigned int>(std::lround(CHARACTER_DISPLAY_SIZE.x * COOKED_OVERSAMPLE)),
+            static_cast<unsigned int>(std::lround(CHARACTER_DISPLAY_SIZE.y * COOKED_OVERSAMPLE))};
+}
+
+bool AssetCooker::cook(const std::string& sourcePath, const std::string& cookedPath, sf::Vector2u targetSize) {
+    sf::Image source;
+    if (!source.loadFromFile(sourcePath)) {
+        std::cerr << "Error: Could not load " << sourcePath << std::endl;
+        return false;
+    }
+    sf::Image cooked = downsample(source, targetSize);
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(cookedPath).parent_path(), error);
+    if (!cooked.saveToFile(cookedPath)) {
+        std::cerr << "Error: Could not write " << cookedPath << std::endl;
+        return false;
+    }
+    std::cout << "Cooked " << sourcePath << " -> " << cookedPath
+              << " (" << targetSize.x << "x" << targetSize.y << ")" << std::endl;
+    return true;
+}
+
+bool AssetCooker::loadCooked(const std::string& sourcePath, const std::string& cookedPath,
+                             sf::Vector2u targetSize, sf::Image& image) {
+    if (image.loadFromFile(cookedPath) && image.getSize() == targetSize) return true;
+
+    sf::Image source;
+    if (!source.loadFromFile(sourcePath)) return false;
+
+    std::cout << "Warning: No cooked asset at " << cookedPath << ", cooking at runtime." << std::endl;
+    image = downsample(source, targetSize);
+
+    // Cache for the next start; failure only costs the runtime cook again
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(cookedPath).parent_path(), error);
+    if (!image.saveToFile(cookedPath)) {
+        std::cout << "Warning: Could not cache " << cookedPath << std::endl;
+    }
+    return true;
+}
+
+bool AssetCooker::createTexture(const sf::Image& image, sf::Texture& texture) {
+    if (!texture.loadFromImage(image)) return false;
+    texture.setSmooth(true);
+    if (!texture.generateMipmap()) {
+        std::cout << "Warning: Mipmaps not supported, using base level only." << std::endl;
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef ASSET_COOKER_H
+#define ASSET_COOKER_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// On-screen size of the character art (the 832x1432 sources drawn at 5%)
+constexpr sf::Vector2f CHARACTER_DISPLAY_SIZE(41.6f, 71.6f);
+
+// Cooked textures keep 2x the display size so the mip chain has a level
+// just above and just below the size actually drawn
+constexpr float COOKED_OVERSAMPLE = 2.0f;
+
+// AssetCooker - Turns oversized source art into right-sized textures.
+// Used offline by tools/CookAssets.cpp and at runtime as a fallback when
+// no cooked file exists yet.
+class AssetCooker {
+public:
+    // Area-averaging downsample with premultiplied alpha (no dark fringes)
+    static sf::Image downsample(const sf::Image& source, sf::Vector2u targetSize);
+
+    // Size a cooked character texture should have
+    static sf::Vector2u cookedCharacterSize();
+
+    // Load sourcePath, downsample it and write the result to cookedPath
+    static bool cook(const std::string& sourcePath, const std::string& cookedPath, sf::Vector2u targetSize);
+
+    // Load the cooked image if present, otherwise cook from the source (and
+    // try to cache the result on disk for the next start)
+    static bool loadCooked(const std::string& sourcePath, const std::string& cookedPath,
+                           sf::Vector2u targetSize, sf::Image& image);
+
+    // Upload an image as a smooth, mipmapped texture
+    static bool createTexture(const sf::Image& image, sf::Texture& texture);
+};
+
+#endif // ASSET_COOKER_H
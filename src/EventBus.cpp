@@ -0,0 +1,36 @@
+/*
+ * Museum Escape - Event Bus Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "EventBus.h"
+
+EventBus::EventBus() : nextId(1) {}
+
+EventBus::SubscriptionId EventBus::subscribe(GameEvent::Type type, Handler handler) {
+    SubscriptionId id = nextId++;
+    subscribers[static_cast<std::size_t>(type)].push_back({id, std::move(handler)});
+    return id;
+}
+
+void EventBus::unsubscribe(SubscriptionId id) {
+    for (auto& list : subscribers) {
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (it->id == id) {
+                list.erase(it);
+                return;
+            }
+        }
+    }
+}
+
+void EventBus::publish(const GameEvent& event) {
+    // Handlers may publish further events; subscribing from inside a
+    // handler of the same type is not supported
+    auto& list = subscribers[static_cast<std::size_t>(event.type)];
+    for (std::size_t i = 0; i < list.size(); i++) list[i].handler(event);
+}
+
+void EventBus::publish(GameEvent::Type type, ItemId item, int roomID) {
+    publish(GameEvent{type, item, roomID});
+}
@@ -0,0 +1,52 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "ItemRegistry.h"
+
+// GameEvent - A gameplay state change. Derived state (door colors, the win
+// check, HUD text) is recomputed when one of these fires, never per frame.
+struct GameEvent {
+    enum class Type {
+        ITEM_COLLECTED, // item: what was added to the inventory
+        ITEM_REMOVED,   // item: what left the inventory
+        DOOR_UNLOCKED,  // item: key used; roomID: room the door is in
+        PUZZLE_SOLVED,  // roomID: room the puzzle is in
+        ROOM_CHANGED,   // roomID: room the player is now in
+        ROOM_CONTENTS_CHANGED // roomID: room whose doors, items or obstacles changed
+    };
+    static const std::size_t TYPE_COUNT = 6;
+
+    Type type;
+    ItemId item;
+    int roomID;
+};
+
+// EventBus - In-process publish/subscribe. Handlers run synchronously,
+// in subscription order, inside publish(); with no events nothing runs.
+class EventBus {
+public:
+    using Handler = std::function<void(const GameEvent&)>;
+    using SubscriptionId = std::size_t;
+
+private:
+    struct Subscription {
+        SubscriptionId id;
+        Handler handler;
+    };
+    std::vector<Subscription> subscribers[GameEvent::TYPE_COUNT];
+    SubscriptionId nextId;
+
+public:
+    EventBus();
+
+    SubscriptionId subscribe(GameEvent::Type type, Handler handler);
+    void unsubscribe(SubscriptionId id);
+
+    void publish(const GameEvent& event);
+    void publish(GameEvent::Type type, ItemId item = NO_ITEM, int roomID = -1);
+};
+
+#endif // EVENT_BUS_H
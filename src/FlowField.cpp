@@ -0,0 +1,168 @@
+/*
+ * Museum Escape - Flow Field Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "FlowField.h"
+#include "NavGrid.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const float DIAGONAL_COST = 1.41421356f;
+    const float UNREACHED = std::numeric_limits<float>::infinity();
+    const std::uint8_t NO_STEP = 0xFF;
+
+    // Eight neighbours (the same order as PathService) and each one's opposite
+    const int NEIGHBOUR_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int NEIGHBOUR_Y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+    const std::uint8_t OPPOSITE[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+
+    struct OpenNode {
+        float cost;
+        std::int32_t cell;
+    };
+}
+
+// ============================================================================
+// FlowField
+// ============================================================================
+
+FlowField::FlowField()
+    : grid(nullptr),
+      goal(-1) {}
+
+// Dijkstra outwards from the goal. Moves are symmetric, so a cell reached
+// from a neighbour steps back to that neighbour to head for the goal.
+void FlowField::build(const NavGrid& navGrid, int goalCell) {
+    PROFILE_SCOPE("FlowField::build");
+    grid = &navGrid;
+    goal = -1;
+    cost.assign(grid->getCellCount(), UNREACHED);
+    next.assign(grid->getCellCount(), NO_STEP);
+    if (goalCell < 0 || goalCell >= static_cast<int>(cost.size()) || grid->isBlocked(goalCell)) return;
+
+    auto after = [](const OpenNode& a, const OpenNode& b) { return a.cost > b.cost; };
+    const int columns = grid->getColumns();
+    std::vector<OpenNode> open;
+    open.reserve(cost.size());
+    cost[goalCell] = 0.0f;
+    open.push_back({0.0f, goalCell});
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), after);
+        OpenNode node = open.back();
+        open.pop_back();
+        if (node.cost > cost[node.cell]) continue; // Stale entry
+
+        int column = node.cell % columns;
+        int row = node.cell / columns;
+        for (int i = 0; i < 8; i++) {
+            int dx = NEIGHBOUR_X[i];
+            int dy = NEIGHBOUR_Y[i];
+            if (grid->isBlocked(column + dx, row + dy)) continue;
+            bool diagonal = dx != 0 && dy != 0;
+            if (diagonal && (grid->isBlocked(column + dx, row) || grid->isBlocked(column, row + dy))) continue;
+
+            int neighbour = (row + dy) * columns + column + dx;
+            float reached = node.cost + (diagonal ? DIAGONAL_COST : 1.0f);
+            if (!(reached < cost[neighbour])) continue;
+            cost[neighbour] = reached;
+            next[neighbour] = OPPOSITE[i];
+            open.push_back({reached, neighbour});
+            std::push_heap(open.begin(), open.end(), after);
+        }
+    }
+    goal = goalCell;
+}
+
+bool FlowField::isBuilt() const { return goal >= 0; }
+int FlowField::getGoal() const { return goal; }
+const NavGrid* FlowField::getGrid() const { return grid; }
+float FlowField::getCost(int cell) const { return cost[cell]; }
+
+bool FlowField::step(const sf::Vector2f& position, sf::Vector2f& waypoint) const {
+    if (goal < 0) return false;
+    int cell = grid->cellAt(position);
+    std::uint8_t direction = next[cell];
+    if (direction == NO_STEP) return false;
+
+    int columns = grid->getColumns();
+    waypoint = grid->centerOf(cell + NEIGHBOUR_Y[direction] * columns + NEIGHBOUR_X[direction]);
+    return true;
+}
+
+// ============================================================================
+// FlowFieldWorker
+// ============================================================================
+
+FlowFieldWorker::FlowFieldWorker()
+    : nextJob(NO_JOB + 1),
+      completed(NO_JOB),
+      stopping(false)
+{
+#if PROFILER_ENABLED
+    Profiler::global(); // Constructed first so it outlives the worker's ring
+#endif
+    worker = std::thread(&FlowFieldWorker::run, this);
+}
+
+FlowFieldWorker::~FlowFieldWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+FlowFieldWorker& FlowFieldWorker::global() {
+    static FlowFieldWorker flowWorker;
+    return flowWorker;
+}
+
+// Worker: build one field at a time, outside the lock. Pending tasks are
+// still finished when stopping, so no waiter is left hanging.
+void FlowFieldWorker::run() {
+    PROFILE_THREAD("FlowFieldWorker");
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            task = queue.front();
+            queue.pop_front();
+        }
+
+        task.out->build(*task.grid, task.goal);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            completed = task.job;
+        }
+        finished.notify_all();
+    }
+}
+
+FlowFieldWorker::Job FlowFieldWorker::submit(const NavGrid& grid, int goalCell, FlowField& out) {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = nextJob++;
+        queue.push_back({job, &grid, goalCell, &out});
+    }
+    wake.notify_one();
+    return job;
+}
+
+void FlowFieldWorker::wait(Job job) {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this, job] { return completed >= job; });
+}
+
+bool FlowFieldWorker::isDone(Job job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return completed >= job;
+}
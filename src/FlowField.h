@@ -0,0 +1,85 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <SFML/System/Vector2.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class NavGrid;
+
+// FlowField - Distance to one goal cell from every cell of a NavGrid
+// (Dijkstra over 8-way moves, no corner cutting), stored with the step
+// each cell takes towards the goal. Built once per goal cell, it routes
+// any number of guards: each one only reads the entry for its own cell.
+class FlowField {
+private:
+    const NavGrid* grid;
+    int goal;                       // -1: not built
+    std::vector<float> cost;        // Path length to the goal, in cells
+    std::vector<std::uint8_t> next; // Neighbour index towards the goal
+
+public:
+    // Constructor - an empty field that routes nothing
+    FlowField();
+
+    // Replace the contents with the field towards goalCell
+    void build(const NavGrid& navGrid, int goalCell);
+
+    bool isBuilt() const;
+    int getGoal() const;
+    const NavGrid* getGrid() const;
+    float getCost(int cell) const; // Infinity where the goal cannot be reached
+
+    // Center of the next cell downhill from position. False in the goal
+    // cell itself and where the field does not reach: head straight there.
+    bool step(const sf::Vector2f& position, sf::Vector2f& waypoint) const;
+};
+
+// FlowFieldWorker - One background thread that builds flow fields in
+// submission order. A submitted field and its grid must stay untouched
+// until wait() for that job returns.
+class FlowFieldWorker {
+public:
+    typedef std::uint64_t Job;
+    static constexpr Job NO_JOB = 0;
+
+private:
+    struct Task {
+        Job job;
+        const NavGrid* grid;
+        int goal;
+        FlowField* out;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wake;     // Worker: a task arrived (or stop)
+    std::condition_variable finished; // Waiters: a task completed
+    std::deque<Task> queue;
+    Job nextJob;
+    Job completed; // Tasks finish in order: every job up to this one is done
+    bool stopping;
+    std::thread worker;
+
+    void run();
+
+public:
+    FlowFieldWorker();
+    ~FlowFieldWorker();
+
+    FlowFieldWorker(const FlowFieldWorker&) = delete;
+    FlowFieldWorker& operator=(const FlowFieldWorker&) = delete;
+
+    // Shared by every room
+    static FlowFieldWorker& global();
+
+    Job submit(const NavGrid& grid, int goalCell, FlowField& out);
+    void wait(Job job); // Returns at once for NO_JOB and finished jobs
+    bool isDone(Job job);
+};
+
+#endif // FLOW_FIELD_H
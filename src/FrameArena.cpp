@@ -0,0 +1,83 @@
+/*
+ * Museum Escape - Frame Arena Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    std::uintptr_t alignUp(std::uintptr_t value, std::size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameArena::FrameArena(std::size_t initialCapacity)
+    : block(new unsigned char[initialCapacity]),
+      capacity(initialCapacity),
+      used(0),
+      spilledBytes(0),
+      peak(0)
+{
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    // new[] storage is aligned for max_align_t, so offsets are enough
+    std::size_t offset = alignUp(used, alignment);
+    if (offset + size <= capacity) {
+        used = offset + size;
+        peak = std::max(peak, used + spilledBytes);
+        return block.get() + offset;
+    }
+
+    // Overflow: a block of its own for this allocation, folded into the
+    // main block at the next reset
+    spills.emplace_back(new unsigned char[size + alignment]);
+    spilledBytes += size + alignment;
+    peak = std::max(peak, used + spilledBytes);
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(spills.back().get());
+    return reinterpret_cast<void*>(alignUp(address, alignment));
+}
+
+std::string_view FrameArena::format(const char* pattern, ...) {
+    std::size_t offset = used;
+    std::size_t room = capacity - offset;
+
+    va_list args;
+    va_start(args, pattern);
+    va_list retry;
+    va_copy(retry, args);
+    int length = std::vsnprintf(reinterpret_cast<char*>(block.get() + offset), room, pattern, args);
+    va_end(args);
+    if (length < 0) {
+        va_end(retry);
+        return std::string_view();
+    }
+
+    // Claim what was written in place, or write it again into a spill block
+    char* text = static_cast<char*>(allocate(static_cast<std::size_t>(length) + 1, 1));
+    if (static_cast<std::size_t>(length) >= room) {
+        std::vsnprintf(text, static_cast<std::size_t>(length) + 1, pattern, retry);
+    }
+    va_end(retry);
+    return std::string_view(text, static_cast<std::size_t>(length));
+}
+
+void FrameArena::reset() {
+    if (!spills.empty()) {
+        // Grow to fit the frame that just overflowed, plus headroom
+        std::size_t needed = used + spilledBytes;
+        while (capacity < needed) capacity *= 2;
+        block.reset(new unsigned char[capacity]);
+        spills.clear();
+        spilledBytes = 0;
+    }
+    used = 0;
+}
+
+std::size_t FrameArena::getUsed() const { return used + spilledBytes; }
+std::size_t FrameArena::getCapacity() const { return capacity; }
+std::size_t FrameArena::getPeak() const { return peak; }
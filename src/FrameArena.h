@@ -0,0 +1,60 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// FrameArena - Linear allocator for things that live for one frame:
+// formatted UI strings and other scratch. Allocation is a pointer bump and
+// reset() frees everything at once. A frame that outgrows the block spills
+// into extra blocks; the next reset() merges them into one block big enough
+// for that frame, so a steady state settles at zero heap allocations.
+// Nothing allocated here has its destructor run.
+class FrameArena {
+public:
+    static const std::size_t DEFAULT_CAPACITY = 64u * 1024u;
+
+private:
+    std::unique_ptr<unsigned char[]> block;
+    std::size_t capacity;
+    std::size_t used;
+    std::vector<std::unique_ptr<unsigned char[]>> spills; // Only while a frame overflows
+    std::size_t spilledBytes;
+    std::size_t peak; // Most bytes any frame needed
+
+public:
+    // Constructor
+    FrameArena(std::size_t initialCapacity = DEFAULT_CAPACITY);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // printf into the arena; the view is valid until the next reset()
+    std::string_view format(const char* pattern, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    // End of frame: everything allocated since the last reset is gone
+    void reset();
+
+    std::size_t getUsed() const;
+    std::size_t getCapacity() const;
+    std::size_t getPeak() const;
+};
+
+#endif // FRAME_ARENA_H
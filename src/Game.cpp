@@ -8,266 +8,331 @@
 #include "Puzzle.h"
 #include "Guard.h"
 #include "Item.h"
+#include "AssetCooker.h"
+#include "Profiler.h"
+#include "AllocationCounter.h"
+#include "GlyphCache.h"
 #include <iostream>
 #include <cmath>
+#include <chrono>
 
-Game::Game() 
+// Longest real frame the simulation will catch up on; anything beyond is
+// dropped rather than running an unbounded number of ticks
+static const float MAX_FRAME_TIME = 0.25f;
+
+// Profiling builds: F4 writes the trace here, F3's overlay refreshes this often
+static const char* const TRACE_PATH = "profile.json";
+static const float STATS_REFRESH = 0.5f;
+
+Game::Game(float simulationRate) 
     : window(sf::VideoMode({800u, 600u}), "Museum Escape"),
-      currentState(GameState::MENU),
       deltaTime(0.0f),
-      currentRoomID(1),
-      activePuzzle(nullptr),
-      stateText(defaultFont),
-      notificationText(notificationFont),
-      notificationTimer(0.0f),
-      notificationColor(sf::Color::White)
+      simulationStep(1.0f / simulationRate),
+      accumulator(0.0f),
+      renderAlpha(0.0f),
+      stateText(placeholderFont()),
+      menuControls(placeholderFont()),
+      menuStart(placeholderFont()),
+      hud(placeholderFont()),
+      lastFrameLayouts(0),
+      lastFrameAllocations(0),
+      notificationText(placeholderFont())
 {
-    window.setFramerateLimit(60);
+    // No frame cap: gameplay speed comes from the fixed step, not the frame rate
     initialize();
 }
 
-Game::~Game() {}
+Game::~Game() {
+    if (recorder.isOpen()) recorder.close(sim->checksum());
+}
 
 void Game::initialize() {
     loadAssets();
-    player = std::make_unique<Player>(100.0f, 100.0f, playerTexture);
-    gameTimer = std::make_unique<Timer>(600.0f);
-    gameTimer->setDisplayPosition(650.0f, 20.0f);
-    gameTimer->setFont(mainFont);
-    inventory = std::make_unique<Inventory>(10);
-    inventory->setFont(mainFont);
-    createRooms();
+    sim = std::make_unique<Simulation>(*playerTexture, *guardTexture);
+    // The bus lives as long as the simulation, across restarts
+    sim->getEvents().subscribe(GameEvent::Type::ROOM_CHANGED, [this](const GameEvent&) {
+        if (auto room = sim->getCurrentRoom()) hud.setRoomName(room->getRoomName());
+        focusRoomStreaming();
+    });
+    // Redraw the cached scenery only when it changes: doors unlock, items
+    // appear or are picked up, and inventory changes recolor the doors (a
+    // room change redraws it through focusRoomStreaming)
+    auto sceneryChanged = [this](const GameEvent&) { staticLayer.invalidate(); };
+    sim->getEvents().subscribe(GameEvent::Type::DOOR_UNLOCKED, sceneryChanged);
+    sim->getEvents().subscribe(GameEvent::Type::ROOM_CONTENTS_CHANGED, sceneryChanged);
+    sim->getEvents().subscribe(GameEvent::Type::ITEM_COLLECTED, sceneryChanged);
+    sim->getEvents().subscribe(GameEvent::Type::ITEM_REMOVED, sceneryChanged);
+    attachSimulation();
     std::cout << "Current Working Directory: " << std::filesystem::current_path() << std::endl;
     std::cout << "Looking for assets at: " << std::filesystem::current_path() / "assets" << std::endl;
     // --------------------------------
     
-    bool fontLoaded = false;
-    setupPuzzles();
-    stateText.setFont(mainFont);
+    stateText.setFont(*mainFont);
     stateText.setCharacterSize(30);
     stateText.setFillColor(sf::Color::White);
     stateText.setPosition({250.0f, 250.0f});
-    notificationText.setFont(mainFont);
+    notificationText.setFont(*mainFont);
     notificationText.setCharacterSize(24);
-    notificationText.setPosition({50.0f, 50.0f});
-    notificationText.setOutlineThickness(2.0f);
-    notificationText.setOutlineColor(sf::Color::Black);
+    notificationText.setPosition({400.0f, 60.0f}, TextAlign::CENTER);
+    notificationText.setOutline(2.0f, sf::Color::Black);
+    hud.setFont(*mainFont);
     overlay.setSize({800.0f, 600.0f});
     overlay.setFillColor(sf::Color(0, 0, 0, 150));
+    
+    // Main menu, built once instead of every frame
+    menuBackground.setSize({800.0f, 600.0f});
+    menuBackground.setFillColor(sf::Color(20, 20, 35));
+    menuTitleBar.setSize({800.0f, 120.0f});
+    menuTitleBar.setPosition({0.0f, 100.0f});
+    menuTitleBar.setFillColor(sf::Color(0, 0, 0, 100));
+    menuTitleBar.setOutlineThickness(2.0f);
+    menuTitleBar.setOutlineColor(sf::Color::Yellow);
+    menuControlsBox.setSize({400.0f, 200.0f});
+    menuControlsBox.setPosition({200.0f, 300.0f});
+    menuControlsBox.setFillColor(sf::Color(50, 50, 50));
+    menuControlsBox.setOutlineThickness(1.0f);
+    menuControlsBox.setOutlineColor(sf::Color::White);
+    menuControls.setFont(*mainFont);
+    menuControls.setCharacterSize(20);
+    menuControls.setString("CONTROLS\n\nWASD  - Move\nE     - Interact / Pickup\nP     - Puzzle\nI     - Inventory");
+    menuControls.setPosition({220.0f, 320.0f});
+    menuStart.setFont(*mainFont);
+    menuStart.setCharacterSize(24);
+    menuStart.setString("- Press ENTER to Start -");
+    menuStart.setPosition({400.0f, 530.0f}, TextAlign::CENTER);
     std::cout << "Game initialized successfully!" << std::endl;
 }
 
 void Game::loadAssets() {
-    bool fontLoaded = false;
-    if (mainFont.openFromFile("assets/arial.ttf")) fontLoaded = true;
-    else if (mainFont.openFromFile("arial.ttf")) fontLoaded = true;
-    else if (mainFont.openFromFile("D:/Assignments/Sem3/OOP/Prozect/main/assets/arial.ttf")) fontLoaded = true;
+    // Everything comes from the packed archive when there is one (see
+    // tools/PackAssets); loose files are the fallback for each asset
+    if (std::filesystem::exists(AssetArchive::DEFAULT_PATH) && archive.open(AssetArchive::DEFAULT_PATH)) {
+        std::cout << "Asset archive: " << archive.getEntryCount() << " entries" << std::endl;
+        roomStreamer.setArchive(&archive);
+    }
     
-    if (!fontLoaded) std::cerr << "Warning: Could not load font!" << std::endl;
+    // One font shared by every Puzzle, Timer and Inventory
+    mainFont = resources.fonts.acquire("main", [this](sf::Font& font) {
+        return archive.load(font, "assets/arial.ttf")
+            || font.openFromFile("arial.ttf");
+    });
+    if (!mainFont) {
+        std::cerr << "Warning: Could not load font!" << std::endl;
+        mainFont = std::make_shared<sf::Font>();
+    } else {
+        // Rasterize every size the game draws now rather than mid-frame
+        sf::Clock warmClock;
+        std::size_t glyphs = GlyphCache::prewarm(*mainFont, GlyphCache::gameStyles());
+        std::cout << "Pre-warmed " << glyphs << " glyphs in " << warmClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
     
-    if (!playerTexture.loadFromFile("assets/player.png")) {
-        sf::Image img; img.resize({40, 40}, sf::Color::Green);
-        if(!playerTexture.loadFromImage(img)) {}
+    // Character art: prefer the pre-scaled copies from tools/CookAssets,
+    // cooking at runtime if they are missing. Decoded to images first so the
+    // same pixels can be packed into the atlas.
+    sf::Vector2u cookedSize = AssetCooker::cookedCharacterSize();
+    auto loadCharacter = [&](const std::string& name, sf::Image& image) {
+        const std::string cooked = "assets/cooked/" + name;
+        if (archive.contains(cooked) && archive.load(image, cooked) && image.getSize() == cookedSize) return true;
+        return AssetCooker::loadCooked("assets/" + name, cooked, cookedSize, image);
+    };
+    sf::Image playerImage, guardImage;
+    if (!loadCharacter("player.png", playerImage)) {
+        playerImage.resize({40, 40}, sf::Color::Green);
         std::cout << "Warning: player.png not found." << std::endl;
     }
-    if (!guardTexture.loadFromFile("assets/guard.png")) {
-        sf::Image img; img.resize({40, 40}, sf::Color::Red);
-        if(!guardTexture.loadFromImage(img)) {}
+    if (!loadCharacter("guard.png", guardImage)) {
+        guardImage.resize({40, 40}, sf::Color::Red);
         std::cout << "Warning: guard.png not found." << std::endl;
     }
+    playerTexture = resources.textures.acquire("player", [&](sf::Texture& texture) {
+        return AssetCooker::createTexture(playerImage, texture);
+    });
+    guardTexture = resources.textures.acquire("guard", [&](sf::Texture& texture) {
+        return AssetCooker::createTexture(guardImage, texture);
+    });
+    if (!playerTexture) {
+        std::cerr << "Error: Failed to create player texture." << std::endl;
+        playerTexture = std::make_shared<sf::Texture>();
+    }
+    if (!guardTexture) {
+        std::cerr << "Error: Failed to create guard texture." << std::endl;
+        guardTexture = std::make_shared<sf::Texture>();
+    }
+    
+    atlas.add(*playerTexture, playerImage);
+    atlas.add(*guardTexture, guardImage);
+    if (atlas.build()) spriteBatch.setAtlas(&atlas);
+    else std::cerr << "Warning: Sprite batching disabled." << std::endl;
+    lighting.load();
     std::cout << "Assets loaded!" << std::endl;
 }
 
-void Game::createRooms() {
-    // Create Rooms with Backgrounds
-    auto room1 = std::make_shared<Room>(1, "Entrance Hall", 0, 0, 800, 600, "assets/room1.png");
-    auto guard1 = std::make_shared<Guard>(200.0f, 200.0f, 100.0f, guardTexture);
-    guard1->addPatrolPoint(200.0f, 200.0f); guard1->addPatrolPoint(600.0f, 200.0f);
-    guard1->addPatrolPoint(600.0f, 400.0f); guard1->addPatrolPoint(200.0f, 400.0f);
-    room1->addGuard(guard1);
-    rooms[1] = room1;
-    
-    auto room2 = std::make_shared<Room>(2, "Storage Room", 0, 0, 800, 600, "assets/room2.png");
-    auto guard2 = std::make_shared<Guard>(150.0f, 300.0f, 110.0f, guardTexture);
-    guard2->addPatrolPoint(150.0f, 300.0f); guard2->addPatrolPoint(650.0f, 300.0f);
-    room2->addGuard(guard2);
-    rooms[2] = room2;
-    
-    auto room3 = std::make_shared<Room>(3, "Artifact Room", 0, 0, 800, 600, "assets/room3.png");
-    auto secretCode = std::make_shared<Passcode>("Secret Code", "4738", 650.0f, 150.0f);
-    room3->addItem(secretCode);
-    auto guard3 = std::make_shared<Guard>(300.0f, 200.0f, 100.0f, guardTexture);
-    guard3->addPatrolPoint(300.0f, 200.0f); guard3->addPatrolPoint(500.0f, 400.0f);
-    room3->addGuard(guard3);
-    rooms[3] = room3;
-    
-    auto room4 = std::make_shared<Room>(4, "Security Office", 0, 0, 800, 600, "assets/room4.png");
-    auto guard4a = std::make_shared<Guard>(150.0f, 200.0f, 110.0f, guardTexture);
-    guard4a->addPatrolPoint(150.0f, 200.0f); guard4a->addPatrolPoint(650.0f, 200.0f);
-    room4->addGuard(guard4a);
-    auto guard4b = std::make_shared<Guard>(650.0f, 450.0f, 110.0f, guardTexture);
-    guard4b->addPatrolPoint(650.0f, 450.0f); guard4b->addPatrolPoint(150.0f, 450.0f);
-    room4->addGuard(guard4b);
-    rooms[4] = room4;
-    
-    auto room5 = std::make_shared<Room>(5, "Exit Hall", 0, 0, 800, 600, "assets/room5.png");
-    room5->setExitRoom(true);
-    rooms[5] = room5;
-    
-    // Connect Rooms with Doors
-    // --- FIXED: Using "Master Key" instead of "master_key" to match Item Name ---
+// The simulation builds its world without fonts or images; give the new
+// world what it needs to be drawn. Called again whenever the world is rebuilt.
+void Game::attachSimulation() {
+    sim->setFont(mainFont);
+    staticLayer.invalidate(); // A rebuilt world may reuse the old room's address
+    focusRoomStreaming();
+    if (auto room = sim->getCurrentRoom()) hud.setRoomName(room->getRoomName());
+}
+
+// Stream the current room's background, then those of the rooms its doors
+// lead to, so walking through a door usually finds its image resident.
+// Only the current room holds a texture, so the streamer can evict the rest.
+void Game::focusRoomStreaming() {
+    std::shared_ptr<Room> room = sim->getCurrentRoom();
+    if (!room) return;
+    std::shared_ptr<Room> previous = texturedRoom.lock();
+    if (previous && previous != room) previous->setBackground(nullptr);
+    texturedRoom = room;
     
-    room1->addDoor(std::make_shared<Door>(750.0f, 300.0f, 2, false, "")); 
-    
-    room2->addDoor(std::make_shared<Door>(50.0f, 300.0f, 1, false, ""));
-    room2->addDoor(std::make_shared<Door>(750.0f, 300.0f, 3, true, "Master Key")); // FIXED
-    
-    room3->addDoor(std::make_shared<Door>(50.0f, 300.0f, 2, false, "")); 
-    room3->addDoor(std::make_shared<Door>(750.0f, 300.0f, 4, false, ""));
-    
-    room4->addDoor(std::make_shared<Door>(50.0f, 300.0f, 3, false, "")); 
-    room4->addDoor(std::make_shared<Door>(750.0f, 300.0f, 5, true, "Security Card")); // FIXED
-    
-    room5->addDoor(std::make_shared<Door>(50.0f, 300.0f, 4, false, ""));
+    std::vector<std::string> wanted{room->getBackgroundPath()};
+    for (auto& door : room->getDoors()) wanted.push_back(sim->getRoomBackgroundPath(door->getTargetRoomID()));
+    roomStreamer.focus(wanted);
+    room->setBackground(roomStreamer.get(room->getBackgroundPath()));
+    staticLayer.invalidate();
+}
+
+// Per frame: upload what the worker finished; the room shows a flat color
+// until its own image arrives
+void Game::showStreamedBackground() {
+    roomStreamer.update();
+    std::shared_ptr<Room> room = texturedRoom.lock();
+    if (room && !room->hasBackground()) {
+        room->setBackground(roomStreamer.get(room->getBackgroundPath()));
+        if (room->hasBackground()) staticLayer.invalidate();
+    }
 }
 
-void Game::setupPuzzles() {
-    auto patternPuzzle = std::make_shared<PatternPuzzle>(std::vector<int>{1, 3, 2, 4});
-    patternPuzzle->setFont(mainFont); rooms[2]->addPuzzle(patternPuzzle);
-    auto riddle = std::make_shared<RiddlePuzzle>("I speak without a mouth and hear without ears.\nI have no body, but come alive with wind.\nWhat am I?", "echo");
-    riddle->setFont(mainFont); rooms[3]->addPuzzle(riddle);
-    auto lockPuzzle = std::make_shared<LockPuzzle>("4738");
-    lockPuzzle->setFont(mainFont); rooms[4]->addPuzzle(lockPuzzle);
+void Game::setSimulationRate(float ticksPerSecond) {
+    if (ticksPerSecond > 0.0f) simulationStep = 1.0f / ticksPerSecond;
 }
 
-void Game::run() {
-    while (window.isOpen()) {
-        deltaTime = clock.restart().asSeconds();
-        processEvents();
-        update();
-        render();
-    }
-}
+float Game::getSimulationRate() const { return 1.0f / simulationStep; }
 
-void Game::processEvents() {
-    while (const std::optional event = window.pollEvent()) {
-        if (event->is<sf::Event::Closed>()) window.close();
-        switch (currentState) {
-            case GameState::MENU: handleMenuInput(*event); break;
-            case GameState::PLAYING: handlePlayingInput(*event); break;
-            case GameState::PUZZLE_ACTIVE: handlePuzzleInput(*event); break;
-            case GameState::PAUSED: handlePauseInput(*event); break;
-            default: break;
-        }
-    }
+bool Game::loadLevel(const std::string& path) {
+    if (!sim->loadLevel(path)) return false;
+    attachSimulation();
+    return true;
 }
 
-void Game::handleMenuInput(const sf::Event& event) {
-    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Enter) {
-            currentState = GameState::PLAYING;
-            gameTimer->start();
-            std::cout << "Game Started!" << std::endl;
-        }
-    }
+bool Game::startRecording(const std::string& path) {
+    std::uint32_t seed = static_cast<std::uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    if (!recorder.open(path, simulationStep, seed)) return false;
+    
+    // The log starts from a known world: fresh rooms, recorded seed
+    sim->restart(seed);
+    attachSimulation();
+    std::cout << "Recording input to " << path << std::endl;
+    return true;
 }
 
-void Game::handlePlayingInput(const sf::Event& event) {
-    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Space) pauseGame();
-        if (keyPressed->code == sf::Keyboard::Key::I) inventory->toggleVisibility();
-        if (keyPressed->code == sf::Keyboard::Key::E) { checkDoorInteraction(); checkItemPickup(); }
-        if (keyPressed->code == sf::Keyboard::Key::P) checkPuzzleInteraction();
-    }
+bool Game::startReplay(const std::string& path) {
+    auto log = std::make_unique<InputReplay>();
+    if (!log->load(path)) return false;
+    
+    // Same step and seed as the recording, or the replay diverges
+    simulationStep = log->getHeader().simulationStep;
+    sim->restart(log->getHeader().seed);
+    attachSimulation();
+    replay = std::move(log);
+    std::cout << "Replaying " << path << " (" << replay->getHeader().tickCount << " ticks)" << std::endl;
+    return true;
 }
 
-void Game::handlePuzzleInput(const sf::Event& event) {
-    if (activePuzzle) {
-        bool wasSolved = activePuzzle->isSolvedStatus();
-        activePuzzle->handleInput(const_cast<sf::Event&>(event));
-        if (!wasSolved && activePuzzle->isSolvedStatus()) {
-            gameTimer->addTime(activePuzzle->getTimeBonus());
-            showNotification("Puzzle Solved! +" + std::to_string(activePuzzle->getTimeBonus()) + "s", sf::Color::Green, 3.0f);
-            if (currentRoomID == 2) {
-                // FIXED: Using "Master Key" for internal ID to match Item Name
-                auto masterKey = std::make_shared<Key>("Master Key", "Master Key", 650.0f, 500.0f);
-                rooms[2]->addItem(masterKey);
-                showNotification("Master Key appeared!", sf::Color::Yellow, 4.0f);
-            } else if (currentRoomID == 4) {
-                // FIXED: Using "Security Card" for internal ID to match Item Name
-                auto securityCard = std::make_shared<Key>("Security Card", "Security Card", 650.0f, 500.0f);
-                rooms[4]->addItem(securityCard);
-                showNotification("Security Card appeared!", sf::Color::Cyan, 4.0f);
-            }
+void Game::run() {
+    PROFILE_THREAD("Main");
+    while (window.isOpen()) {
+        PROFILE_SCOPE("Frame");
+        std::uint64_t allocationsBefore = AllocationCounter::getCount();
+        float frameTime = clock.restart().asSeconds();
+        PROFILE_FRAME(frameTime); // Unclamped: the overlay should show hitches
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        accumulator += frameTime;
+        
+        {
+            PROFILE_SCOPE("Game::processEvents");
+            processEvents();
         }
-    }
-    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Escape) {
-            activePuzzle = nullptr;
-            currentState = GameState::PLAYING;
-            gameTimer->resume();
+        
+        // Consume real time in fixed ticks
+        deltaTime = simulationStep;
+        while (accumulator >= simulationStep) {
+            PROFILE_SCOPE("Game::update");
+            update();
+            accumulator -= simulationStep;
+        }
+        
+        // Fraction of a tick left over: how far to blend toward the newest state
+        renderAlpha = accumulator / simulationStep;
+        showStreamedBackground();
+        {
+            PROFILE_SCOPE("Game::render");
+            render();
         }
+        lastFrameAllocations = AllocationCounter::getCount() - allocationsBefore;
     }
 }
 
-void Game::handlePauseInput(const sf::Event& event) {
-    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        if (keyPressed->code == sf::Keyboard::Key::Space) resumeGame();
+void Game::processEvents() {
+    while (const std::optional event = window.pollEvent()) {
+        if (event->is<sf::Event::Closed>()) window.close();
+        if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
+            if (keyPressed->code == sf::Keyboard::Key::F3) {
+                hud.toggleStats();
+                continue;
+            }
+#if PROFILER_ENABLED
+            if (keyPressed->code == sf::Keyboard::Key::F4) {
+                Profiler::global().exportChromeTrace(TRACE_PATH);
+                continue;
+            }
+#endif
+        }
+        // Everything the simulation reacts to goes through the next tick,
+        // so a recording sees it exactly where the simulation did
+        if (auto input = InputEvent::fromEvent(*event)) pendingEvents.push_back(*input);
     }
 }
 
-void Game::update() {
-    switch (currentState) {
-        case GameState::MENU: updateMenu(); break;
-        case GameState::PLAYING: updatePlaying(); break;
-        case GameState::PUZZLE_ACTIVE: updatePuzzle(); break;
-        case GameState::GAME_OVER: updateGameOver(); break;
-        default: break;
-    }
+// Movement keys held right now, applied to every tick of this frame
+PlayerInput Game::sampleInput() const {
+    PlayerInput input;
+    input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up);
+    input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down);
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right);
+    return input;
 }
 
-void Game::updateMenu() {}
-
-void Game::updatePlaying() {
-    gameTimer->update(deltaTime);
-    if (notificationTimer > 0) notificationTimer -= deltaTime;
-    player->handleInput(deltaTime);
-    player->update(deltaTime);
-    
-    if (rooms.find(currentRoomID) != rooms.end()) {
-        rooms[currentRoomID]->update(deltaTime);
-        
-        // 1. Update Guards (Keep moving!)
-        auto& guards = rooms[currentRoomID]->getGuards();
-        for (auto& guard : guards) guard->update(deltaTime, *player);
+// Input for the next tick: the replay's while one is playing, otherwise
+// the keyboard plus whatever events arrived since the last tick
+TickInput Game::nextTickInput() {
+    TickInput input;
+    if (replay) {
+        pendingEvents.clear(); // Live input is ignored during playback
+        if (replay->next(input)) return input;
         
-        // 2. Update Door Colors
-        auto& doors = rooms[currentRoomID]->getDoors();
-        for (auto& door : doors) {
-            if (door->getLockedStatus()) {
-                std::string keyNeeded = door->getRequiredKey();
-                // Now that names match ("Master Key" == "Master Key"), this will return TRUE
-                if (player->hasItem(keyNeeded)) {
-                    door->setColor(sf::Color::Blue); // READY
-                } else {
-                    door->setColor(sf::Color::Red); // LOCKED
-                }
-            }
+        if (replay->getHeader().checksum != 0) {
+            bool match = replay->getHeader().checksum == sim->checksum();
+            std::cout << "Replay finished: " << (match ? "state matches recording" : "STATE DIVERGED") << std::endl;
         }
+        replay.reset();
     }
-    
-    checkCollisions();
-    checkGuardDetection();
-    checkWinCondition();
-    checkLoseCondition();
+    input.held = sampleInput();
+    input.events.swap(pendingEvents);
+    return input;
 }
 
-void Game::updatePuzzle() { if (activePuzzle) activePuzzle->update(deltaTime); }
-void Game::updateGameOver() {}
+void Game::update() {
+    TickInput input = nextTickInput();
+    recorder.record(input);
+    sim->step(deltaTime, input);
+}
 
 void Game::render() {
     window.clear(sf::Color(20, 20, 30));
-    switch (currentState) {
+    switch (sim->getState()) {
         case GameState::MENU: renderMenu(); break;
         case GameState::PLAYING: renderPlaying(); break;
         case GameState::PUZZLE_ACTIVE: renderPuzzle(); break;
@@ -276,82 +341,73 @@ void Game::render() {
         default: break;
     }
     window.display();
+    
+    lastFrameLayouts = Label::getLayoutCount();
+    Label::resetLayoutCount();
+    frameArena.reset();
 }
 
 void Game::renderMenu() {
-    sf::RectangleShape bg({800.0f, 600.0f});
-    bg.setFillColor(sf::Color(20, 20, 35));
-    window.draw(bg);
-    sf::RectangleShape titleBar({800.0f, 120.0f});
-    titleBar.setPosition({0.0f, 100.0f});
-    titleBar.setFillColor(sf::Color(0, 0, 0, 100));
-    titleBar.setOutlineThickness(2.0f);
-    titleBar.setOutlineColor(sf::Color::Yellow);
-    window.draw(titleBar);
+    window.draw(menuBackground);
+    window.draw(menuTitleBar);
     stateText.setString("MUSEUM ESCAPE");
     stateText.setCharacterSize(60);
     stateText.setStyle(sf::Text::Bold);
     stateText.setFillColor(sf::Color::Yellow);
-    sf::FloatRect bounds = stateText.getLocalBounds();
-    stateText.setPosition({400.0f - bounds.size.x / 2.0f, 120.0f});
+    stateText.setPosition({400.0f, 120.0f}, TextAlign::CENTER);
     window.draw(stateText);
-    sf::RectangleShape controlsBox({400.0f, 200.0f});
-    controlsBox.setPosition({200.0f, 300.0f});
-    controlsBox.setFillColor(sf::Color(50, 50, 50));
-    controlsBox.setOutlineThickness(1.0f);
-    controlsBox.setOutlineColor(sf::Color::White);
-    window.draw(controlsBox);
-    sf::Text controls(mainFont);
-    controls.setString("CONTROLS\n\nWASD  - Move\nE     - Interact / Pickup\nP     - Puzzle\nI     - Inventory");
-    controls.setCharacterSize(20);
-    controls.setFillColor(sf::Color::White);
-    controls.setPosition({220.0f, 320.0f});
-    window.draw(controls);
+    window.draw(menuControlsBox);
+    window.draw(menuControls);
     float time = clock.getElapsedTime().asSeconds();
     int alpha = static_cast<int>((sin(time * 3.0f) + 1.0f) / 2.0f * 255);
-    sf::Text startText(mainFont);
-    startText.setString("- Press ENTER to Start -");
-    startText.setCharacterSize(24);
-    startText.setFillColor(sf::Color(255, 255, 255, alpha));
-    sf::FloatRect startBounds = startText.getLocalBounds();
-    startText.setPosition({400.0f - startBounds.size.x / 2.0f, 530.0f});
-    window.draw(startText);
+    menuStart.setFillColor(sf::Color(255, 255, 255, alpha));
+    window.draw(menuStart);
 }
 
 void Game::renderPlaying() {
-    if (rooms.find(currentRoomID) != rooms.end()) rooms[currentRoomID]->draw(window);
-    player->draw(window);
-    sf::RectangleShape topBar({800.0f, 40.0f});
-    topBar.setFillColor(sf::Color(30, 30, 30));
-    topBar.setOutlineThickness(1.0f);
-    topBar.setOutlineColor(sf::Color(100, 100, 100));
-    window.draw(topBar);
-    sf::Text roomText(mainFont);
-    if (rooms.find(currentRoomID) != rooms.end()) roomText.setString("LOCATION: " + rooms[currentRoomID]->getRoomName());
-    roomText.setCharacterSize(18);
-    roomText.setFillColor(sf::Color::Cyan);
-    roomText.setPosition({10.0f, 8.0f});
-    window.draw(roomText);
-    sf::Text timeText(mainFont);
-    timeText.setString("TIME REMAINING: " + gameTimer->getFormattedTime());
-    timeText.setCharacterSize(18);
-    if(gameTimer->getRemainingTime() < 30.0f) timeText.setFillColor(sf::Color::Red);
-    else timeText.setFillColor(sf::Color::White);
-    sf::FloatRect timeBounds = timeText.getLocalBounds();
-    timeText.setPosition({790.0f - timeBounds.size.x, 8.0f});
-    window.draw(timeText);
-    sf::Text invHint(mainFont);
-    invHint.setString("[I] Inventory  [P] Puzzle  [ESC] Pause");
-    invHint.setCharacterSize(14);
-    invHint.setFillColor(sf::Color(150, 150, 150));
-    invHint.setPosition({550.0f, 580.0f});
-    window.draw(invHint);
-    if (inventory->getVisible()) inventory->draw(window);
-    if (notificationTimer > 0) {
-        notificationText.setString(currentNotification);
-        notificationText.setFillColor(notificationColor);
-        sf::FloatRect notifBounds = notificationText.getLocalBounds();
-        notificationText.setPosition({400.0f - notifBounds.size.x/2.0f, 60.0f});
+    Player& player = sim->getPlayer();
+    Timer& gameTimer = sim->getTimer();
+    Inventory& inventory = sim->getInventory();
+    std::shared_ptr<Room> room = sim->getCurrentRoom();
+    
+    // Place sprites between the last two simulation states
+    player.interpolate(renderAlpha);
+    if (room) {
+        for (auto& guard : room->getGuards()) guard->interpolate(renderAlpha);
+    }
+    
+    // Cached scenery first (one sprite), then the guards and the player
+    // share one batch -> one draw call
+    spriteBatch.clear();
+    if (room) {
+        staticLayer.draw(window, *room, spriteBatch);
+        room->drawGuards(window, spriteBatch, !lighting.isReady());
+    }
+    if (spriteBatch.getAtlas()) {
+        player.draw(spriteBatch);
+        window.draw(spriteBatch);
+    } else {
+        player.draw(window);
+    }
+    // Then every guard's light at once, shading everything drawn so far
+    if (room) lighting.draw(window, *room, renderAlpha);
+    // HUD widgets are retained; only push the values they are bound to
+    hud.setTime(gameTimer.getFormattedTime(), gameTimer.getRemainingTime() < 30.0f);
+    hud.setLayoutStats(lastFrameLayouts, lastFrameAllocations);
+#if PROFILER_ENABLED
+    if (hud.isShowingStats() && statsClock.getElapsedTime().asSeconds() >= STATS_REFRESH) {
+        // A few times a second: redrawing the numbers every frame would
+        // cost text layouts of its own
+        statsClock.restart();
+        Profiler::FrameStats stats = Profiler::global().getFrameStats();
+        hud.setFrameStats(stats.p50, stats.p99, stats.max);
+    }
+#endif
+    hud.draw(window);
+    if (inventory.getVisible()) inventory.draw(window, frameArena);
+    if (sim->hasNotification()) {
+        notificationText.setString(sim->getNotification());
+        notificationText.setFillColor(sim->getNotificationColor());
         window.draw(notificationText);
     }
 }
@@ -359,7 +415,7 @@ void Game::renderPlaying() {
 void Game::renderPuzzle() {
     renderPlaying();
     window.draw(overlay);
-    if (activePuzzle) activePuzzle->display(window);
+    if (auto puzzle = sim->getActivePuzzle()) puzzle->display(window);
 }
 void Game::renderGameOver() {
     window.draw(overlay);
@@ -375,153 +431,3 @@ void Game::renderVictory() {
     stateText.setPosition({230.0f, 250.0f});
     window.draw(stateText);
 }
-
-void Game::changeRoom(int newRoomID) {
-    if (rooms.find(newRoomID) != rooms.end()) {
-        currentRoomID = newRoomID;
-        rooms[currentRoomID]->setVisited(true);
-        player->setPosition(100.0f, 300.0f);
-        std::cout << "\n→ Moved to: " << rooms[currentRoomID]->getRoomName() << std::endl;
-    }
-}
-
-void Game::activatePuzzle(std::shared_ptr<Puzzle> puzzle) {
-    activePuzzle = puzzle;
-    currentState = GameState::PUZZLE_ACTIVE;
-    gameTimer->pause();
-}
-
-void Game::checkCollisions() {
-    auto playerBounds = player->getBounds();
-    sf::Vector2f pos = player->getPosition();
-    if (pos.x < 0) player->setPosition(0, pos.y);
-    if (pos.y < 0) player->setPosition(pos.x, 0);
-    if (pos.x > 800 - playerBounds.size.x) player->setPosition(800 - playerBounds.size.x, pos.y);
-    if (pos.y > 600 - playerBounds.size.y) player->setPosition(pos.x, 600 - playerBounds.size.y);
-}
-
-void Game::checkGuardDetection() {
-    auto& guards = rooms[currentRoomID]->getGuards();
-    for (auto& guard : guards) {
-        if (guard->detectPlayer(*player)) {
-            if (!player->isPlayerWarned()) {
-                player->warn();
-                showNotification("WARNING! Caught by guard!", sf::Color::Yellow, 3.0f);
-                gameTimer->subtractTime(5.0f);
-            } else {
-                showNotification("CAUGHT! Game Over!", sf::Color::Red, 2.0f);
-                setGameOver(false);
-                return;
-            }
-        }
-    }
-}
-
-void Game::checkDoorInteraction() {
-    auto& doors = rooms[currentRoomID]->getDoors();
-    auto playerBounds = player->getBounds();
-    for (auto& door : doors) {
-        if (door->checkCollision(playerBounds)) {
-            if (door->getLockedStatus()) {
-                bool hasKey = false;
-                // --- FIXED: Use the actual required key from the door logic ---
-                std::string requiredKey = door->getRequiredKey(); 
-                
-                auto& inv = player->getInventory();
-                for (auto* item : inv) {
-                    if (item->getName() == requiredKey) {
-                        hasKey = true;
-                        break;
-                    }
-                }
-                if (hasKey) {
-                    door->unlock();
-                    showNotification("Door unlocked with " + requiredKey + "!", sf::Color::Green, 2.0f);
-                    changeRoom(door->getTargetRoomID());
-                } else {
-                    showNotification("LOCKED! Need " + requiredKey, sf::Color::Red, 2.0f);
-                }
-            } else {
-                changeRoom(door->getTargetRoomID());
-            }
-            return;
-        }
-    }
-}
-
-void Game::checkItemPickup() {
-    auto& items = rooms[currentRoomID]->getItems();
-    auto playerBounds = player->getBounds();
-    for (auto& item : items) {
-        if (!item->isItemCollected() && item->checkCollision(playerBounds)) {
-            item->collect();
-            player->addItem(item.get());
-            inventory->addItem(item);
-            
-            if (item->getName() == "Secret Code") {
-                Passcode* passcode = dynamic_cast<Passcode*>(item.get());
-                if (passcode) showNotification("SECRET CODE: " + passcode->getCode(), sf::Color::Yellow, 10.0f);
-            } else {
-                showNotification("Picked up: " + item->getName(), sf::Color::Cyan, 2.0f);
-            }
-        }
-    }
-}
-
-void Game::checkPuzzleInteraction() {
-    auto& puzzles = rooms[currentRoomID]->getPuzzles();
-    for (auto& puzzle : puzzles) {
-        if (!puzzle->isSolvedStatus()) {
-            activatePuzzle(puzzle);
-            if (currentRoomID == 4) showNotification("Enter code from Room 3 Secret Code!", sf::Color::Magenta, 4.0f);
-            return;
-        }
-    }
-}
-
-void Game::checkWinCondition() {
-    if (rooms[currentRoomID]->isExit()) {
-        bool allPuzzlesSolved = true;
-        for (auto& roomPair : rooms) {
-            for (auto& puzzle : roomPair.second->getPuzzles()) {
-                if (!puzzle->isSolvedStatus()) {
-                    allPuzzlesSolved = false;
-                    break;
-                }
-            }
-            if (!allPuzzlesSolved) break;
-        }
-        if (allPuzzlesSolved) setGameOver(true);
-        else showNotification("Solve ALL puzzles to escape!", sf::Color::Red, 2.0f);
-    }
-}
-
-void Game::checkLoseCondition() {
-    if (gameTimer->isExpired()) setGameOver(false);
-}
-
-void Game::setGameOver(bool victory) {
-    currentState = victory ? GameState::VICTORY : GameState::GAME_OVER;
-    gameTimer->stop();
-}
-
-void Game::pauseGame() {
-    currentState = GameState::PAUSED;
-    gameTimer->pause();
-}
-
-void Game::resumeGame() {
-    currentState = GameState::PLAYING;
-    gameTimer->resume();
-}
-
-void Game::resetGame() {
-    currentState = GameState::MENU;
-    gameTimer->reset();
-}
-
-void Game::showNotification(const std::string& message, const sf::Color& color, float duration) {
-    currentNotification = message;
-    notificationColor = color;
-    notificationTimer = duration;
-}
\ No newline at end of file
@@ -6,67 +6,111 @@
 #include <memory>
 #include <vector>
 #include <map>
-#include "Player.h"
-#include "Room.h"
-#include "Timer.h"
-#include "Item.h"
-
-enum class GameState {
-    MENU,
-    PLAYING,
-    PAUSED,
-    PUZZLE_ACTIVE,
-    GAME_OVER,
-    VICTORY
-};
+#include "Simulation.h"
+#include "InputLog.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+#include "ResourceCache.h"
+#include "Hud.h"
+#include "RoomStreamer.h"
+#include "AssetArchive.h"
+#include "FrameArena.h"
+#include "Label.h"
+#include "LightingPass.h"
+#include "StaticLayer.h"
 
+// Game - Window, assets and rendering around a Simulation. Samples the
+// keyboard, steps the simulation at a fixed rate and draws its state.
 class Game {
 private:
     // Window
     sf::RenderWindow window;
     sf::Clock clock;
-    float deltaTime;
+    float deltaTime; // Always the fixed simulation step inside update()
     
-    // Game state
-    GameState currentState;
+    // Fixed-step simulation: real frame time accumulates and is consumed in
+    // whole ticks; rendering interpolates between the last two tick states
+    float simulationStep;
+    float accumulator;
+    float renderAlpha;
     
-    // Core components
-    std::unique_ptr<Player> player;
-    std::unique_ptr<Timer> gameTimer;
-    std::unique_ptr<Inventory> inventory;
+    // Packed assets, mapped for the whole run: the font reads from it
+    // directly, so it is declared before (and destroyed after) everything
+    AssetArchive archive;
     
-    // Rooms
-    std::map<int, std::shared_ptr<Room>> rooms;
-    int currentRoomID;
-    
-    // Active puzzle (when player interacts with one)
-    std::shared_ptr<Puzzle> activePuzzle;
+    // Shared fonts/textures/sounds, handed out as reference-counted handles
+    Resources resources;
     
     // Assets (must be declared before Text objects that use them)
-    sf::Font mainFont;
-    sf::Font defaultFont; // Default font for initialization
-    sf::Font notificationFont; // Font for notifications
+    FontHandle mainFont;
     sf::Music backgroundMusic;
     
     // --- NEW: Texture Assets ---
-    sf::Texture playerTexture;
-    sf::Texture guardTexture;
+    TextureHandle playerTexture;
+    TextureHandle guardTexture;
+    
+    // Room backgrounds, decoded off the main thread and prefetched through doors
+    RoomStreamer roomStreamer;
+    std::weak_ptr<Room> texturedRoom; // The one room currently holding a background
     
-    // UI Elements (declared after fonts)
-    sf::Text stateText; // Regular member, initialized in constructor
+    // Batched rendering: entity textures packed into one atlas
+    TextureAtlas atlas;
+    SpriteBatch spriteBatch;
+    
+    // Guard lights and vision cones, one shader pass over the room (when
+    // shaders are available; the cones are drawn as shapes otherwise)
+    LightingPass lighting;
+    
+    // The current room's scenery, cached in a texture between the gameplay
+    // events that change it
+    StaticLayer staticLayer;
+    
+    // UI Elements (declared after fonts). All retained: a steady frame
+    // builds no text or shapes and makes no heap allocations
+    Label stateText; // Title / game over / victory text
     sf::RectangleShape overlay; // Dark overlay for pause/puzzle screens
+    sf::RectangleShape menuBackground;
+    sf::RectangleShape menuTitleBar;
+    sf::RectangleShape menuControlsBox;
+    Label menuControls;
+    Label menuStart;
+    Hud hud; // Retained top bar / timer / hints
+    unsigned int lastFrameLayouts; // Text re-layouts in the previous frame
+    unsigned long long lastFrameAllocations; // Heap allocations in the previous frame (profiling builds)
+    sf::Clock statsClock; // Paces the frame-time overlay (profiling builds)
+    
+    // Notification system (message and timer live in the simulation)
+    Label notificationText;
     
-    // Notification system
-    sf::Text notificationText;
-    std::string currentNotification;
-    float notificationTimer;
-    sf::Color notificationColor;
+    // Scratch for the frame being drawn (formatted text); reset after display
+    FrameArena frameArena;
+    
+    // Gameplay core; created once the textures it references are loaded
+    std::unique_ptr<Simulation> sim; // HUD room name follows its ROOM_CHANGED events
+    
+    // Discrete input polled this frame, handed to the next tick
+    std::vector<InputEvent> pendingEvents;
+    
+    // Optional session recording / playback of a recorded session
+    InputRecorder recorder;
+    std::unique_ptr<InputReplay> replay;
     
 public:
     // Constructor & Destructor
-    Game();
+    Game(float simulationRate = 120.0f);
     ~Game();
     
+    void setSimulationRate(float ticksPerSecond);
+    float getSimulationRate() const;
+    
+    // Play a different level file (text or compiled)
+    bool loadLevel(const std::string& path);
+    
+    // Record this session to an input log (restarts the world with a new seed)
+    bool startRecording(const std::string& path);
+    // Play a recorded log instead of the keyboard, at its own tick rate
+    bool startReplay(const std::string& path);
+    
     // Game loop
     void run();
     
@@ -74,50 +118,23 @@ private:
     // Initialization
     void initialize();
     void loadAssets();
-    void createRooms();
-    void setupPuzzles();
+    void attachSimulation(); // Fonts and backgrounds for the simulation's world
+    void focusRoomStreaming();
+    void showStreamedBackground();
     
     // Core loop functions
     void processEvents();
     void update();
     void render();
     
-    // State-specific handlers
-    void handleMenuInput(const sf::Event& event);
-    void handlePlayingInput(const sf::Event& event);
-    void handlePuzzleInput(const sf::Event& event);
-    void handlePauseInput(const sf::Event& event);
-    
-    void updateMenu();
-    void updatePlaying();
-    void updatePuzzle();
-    void updateGameOver();
+    PlayerInput sampleInput() const;
+    TickInput nextTickInput();
     
     void renderMenu();
     void renderPlaying();
     void renderPuzzle();
     void renderGameOver();
     void renderVictory();
-    
-    // Game mechanics
-    void changeRoom(int newRoomID);
-    void activatePuzzle(std::shared_ptr<Puzzle> puzzle);
-    void checkCollisions();
-    void checkGuardDetection();
-    void checkDoorInteraction();
-    void checkItemPickup();
-    void checkPuzzleInteraction();
-    
-    // Win/Lose conditions
-    void checkWinCondition();
-    void checkLoseCondition();
-    void setGameOver(bool victory);
-    
-    // Utility
-    void resetGame();
-    void pauseGame();
-    void resumeGame();
-    void showNotification(const std::string& message, const sf::Color& color, float duration = 3.0f);
 };
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+ * Museum Escape - Glyph Cache Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "GlyphCache.h"
+
+const char* const GlyphCache::DEFAULT_CHARSET =
+    " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+const std::vector<GlyphStyle>& GlyphCache::gameStyles() {
+    static const std::vector<GlyphStyle> styles = {
+        {14, false, 0.0f}, // HUD hints and stats, inventory descriptions
+        {15, false, 0.0f}, // Lock puzzle hint
+        {16, false, 0.0f}, // Riddle and pattern puzzle hints
+        {18, false, 0.0f}, // HUD room and time, puzzle prompts and feedback
+        {20, false, 0.0f}, // Menu controls, puzzle text, inputs and buttons, capacity
+        {22, false, 0.0f}, // Inventory item names
+        {24, false, 0.0f}, // Menu start prompt, timer
+        {24, false, 2.0f}, // Notifications (outlined)
+        {26, false, 0.0f}, // Lock puzzle title and clear button
+        {28, false, 0.0f}, // Puzzle titles, keypad digits
+        {28, true, 0.0f},  // Inventory title
+        {30, true, 0.0f},  // Game over / victory (stateText keeps the menu's bold)
+        {32, false, 0.0f}, // Lock puzzle code display
+        {60, true, 0.0f},  // Menu title
+    };
+    return styles;
+}
+
+std::size_t GlyphCache::prewarm(const sf::Font& font, const std::vector<GlyphStyle>& styles, std::string_view charset) {
+    std::size_t glyphs = 0;
+    for (const GlyphStyle& style : styles) {
+        for (char c : charset) {
+            // Outlined text draws the plain glyph over the outline glyph
+            (void)font.getGlyph(static_cast<unsigned char>(c), style.characterSize, style.bold, 0.0f);
+            glyphs++;
+            if (style.outlineThickness != 0.0f) {
+                (void)font.getGlyph(static_cast<unsigned char>(c), style.characterSize, style.bold, style.outlineThickness);
+                glyphs++;
+            }
+        }
+    }
+    return glyphs;
+}
@@ -0,0 +1,35 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// One size/style combination text is drawn with. Italic and underline are
+// drawn from the regular glyphs, so they need no entry of their own.
+struct GlyphStyle {
+    unsigned int characterSize;
+    bool bold;
+    float outlineThickness;
+};
+
+// GlyphCache - Rasterizes glyphs before they are first needed. sf::Font
+// renders glyphs lazily, per size, style and outline, and grows a page
+// texture for each size as it goes; the first frame to show a new size or
+// character pays for that. Pre-warming every combination the game uses at
+// load time moves all of it out of the frame loop.
+class GlyphCache {
+public:
+    static const char* const DEFAULT_CHARSET; // Printable ASCII
+
+    // Every size and style drawn by the game's texts, labels and widgets.
+    // A new text size or style belongs in this list.
+    static const std::vector<GlyphStyle>& gameStyles();
+
+    // Rasterize charset for each style; returns the number of glyphs touched
+    static std::size_t prewarm(const sf::Font& font, const std::vector<GlyphStyle>& styles,
+                               std::string_view charset = DEFAULT_CHARSET);
+};
+
+#endif // GLYPH_CACHE_H
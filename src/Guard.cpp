@@ -5,141 +5,172 @@
 
 #include "Guard.h"
 #include "Player.h"
+#include "SpriteBatch.h"
+#include "AssetCooker.h"
+#include "SpatialHash.h"
+#include "GuardSystem.h"
+#include "Profiler.h"
 #include <cmath>
 
+// Arc segments of the drawn vision cone
+static const std::size_t CONE_SEGMENTS = 16;
+
 // Constructor - CHANGED to use Texture
 Guard::Guard(float x, float y, float detectionRange, const sf::Texture& texture)
-    : position(x, y),
+    : system(nullptr),
+      slot(0),
+      ownSystem(std::make_unique<GuardSystem>()),
       sprite(texture), // <--- FIXED: Initialize sprite with texture here
-      speed(80.0f),
-      currentPatrolIndex(0),
-      movingForward(true),
-      detectionRadius(detectionRange),
-      hasDetectedPlayer(false),
-      detectionCooldown(0.0f),
-      cooldownTime(2.0f),
-      detectionCircle(detectionRange) 
+      spatialIndex(nullptr)
 {
-    sprite.setPosition(position);
+    // Speed 80, detection cooldown 2 seconds
+    system = ownSystem.get();
+    slot = system->add({x, y}, 80.0f, detectionRange, 2.0f);
+    
     sprite.setColor(sf::Color(255, 200, 200)); 
     
-    detectionCircle.setFillColor(sf::Color(255, 0, 0, 30));
-    detectionCircle.setOutlineThickness(1.0f);
-    detectionCircle.setOutlineColor(sf::Color(255, 0, 0, 100));
+    buildCone(detectionRange);
+    detectionCone.setFillColor(sf::Color(255, 0, 0, 30));
+    detectionCone.setOutlineThickness(1.0f);
+    detectionCone.setOutlineColor(sf::Color(255, 0, 0, 100));
     
-    sf::FloatRect bounds = sprite.getLocalBounds();
-    detectionCircle.setOrigin({detectionRange - bounds.size.x/2.0f, detectionRange - bounds.size.y/2.0f});
-    detectionCircle.setPosition(position);
-    sprite.setScale({0.05f, 0.05f});
+    // Scale whatever texture we got (cooked or fallback) to the display size
+    sf::Vector2u texSize = texture.getSize();
+    if (texSize.x > 0 && texSize.y > 0) {
+        sprite.setScale({CHARACTER_DISPLAY_SIZE.x / texSize.x, CHARACTER_DISPLAY_SIZE.y / texSize.y});
+    }
+    
+    placeVisuals({x, y});
+}
+
+// Apex plus an arc across the cone, centered on +x; rotated to the
+// heading whenever the guard is placed
+void Guard::buildCone(float range) {
+    const float halfAngle = GuardSystem::VISION_HALF_ANGLE * 3.14159265f / 180.0f;
+    detectionCone.setPointCount(CONE_SEGMENTS + 2);
+    detectionCone.setPoint(0, {0.0f, 0.0f});
+    for (std::size_t i = 0; i <= CONE_SEGMENTS; i++) {
+        float angle = -halfAngle + 2.0f * halfAngle * static_cast<float>(i) / CONE_SEGMENTS;
+        detectionCone.setPoint(i + 1, {range * std::cos(angle), range * std::sin(angle)});
+    }
 }
 
+Guard::~Guard() {}
+
 // Add patrol point
 void Guard::addPatrolPoint(float x, float y) {
-    patrolPoints.push_back({x, y});
+    std::vector<sf::Vector2f> points = system->getPatrol(slot);
+    points.push_back({x, y});
+    setPatrolPoints(points);
 }
 
 // Set all patrol points at once
 void Guard::setPatrolPoints(const std::vector<sf::Vector2f>& points) {
-    patrolPoints = points;
-    currentPatrolIndex = 0;
+    sf::Vector2f oldPosition = getPosition();
+    system->setPatrol(slot, points); // A single point moves the guard onto it
+    syncIndex(oldPosition);
+}
+
+std::size_t Guard::joinSystem(GuardSystem& target) {
+    if (&target == system) return slot;
+    slot = target.adopt(*system, slot);
+    system = &target;
+    ownSystem.reset();
+    return slot;
 }
 
+GuardSystem& Guard::getSystem() const { return *system; }
+std::size_t Guard::getSlot() const { return slot; }
+
 // Patrol between waypoints
 void Guard::patrol(float deltaTime) {
-    if (patrolPoints.empty()) return;
-    
-    if (patrolPoints.size() == 1) {
-        position = patrolPoints[0];
-        sprite.setPosition(position);
-        detectionCircle.setPosition(position);
-        return;
-    }
-    
-    sf::Vector2f target = patrolPoints[currentPatrolIndex];
-    
-    float dx = target.x - position.x;
-    float dy = target.y - position.y;
-    float distance = std::sqrt(dx * dx + dy * dy);
-    
-    if (distance < 5.0f) {
-        if (movingForward) {
-            currentPatrolIndex++;
-            if (currentPatrolIndex >= patrolPoints.size()) {
-                currentPatrolIndex = patrolPoints.size() - 2;
-                movingForward = false;
-            }
-        } else {
-            currentPatrolIndex--;
-            if (currentPatrolIndex < 0) {
-                currentPatrolIndex = 1;
-                movingForward = true;
-            }
-        }
-    } else {
-        float normalizedX = dx / distance;
-        float normalizedY = dy / distance;
-        
-        position.x += normalizedX * speed * deltaTime;
-        position.y += normalizedY * speed * deltaTime;
-        
-        sprite.setPosition(position);
-        detectionCircle.setPosition(position);
-    }
+    sf::Vector2f oldPosition = getPosition();
+    system->patrolOne(slot, deltaTime);
+    syncIndex(oldPosition);
 }
 
 void Guard::setRoomBounds(const sf::FloatRect& bounds) {
     roomBounds = bounds;
 }
 
+// Guards are indexed as points at their position
+void Guard::setSpatialIndex(SpatialHash<Guard>* index) {
+    if (spatialIndex) spatialIndex->remove(this, sf::FloatRect(getPosition(), {0.0f, 0.0f}));
+    spatialIndex = index;
+    if (spatialIndex) spatialIndex->insert(this, sf::FloatRect(getPosition(), {0.0f, 0.0f}));
+}
+
+void Guard::syncIndex(const sf::Vector2f& oldPosition) {
+    if (!spatialIndex) return;
+    spatialIndex->update(this, sf::FloatRect(oldPosition, {0.0f, 0.0f}), sf::FloatRect(getPosition(), {0.0f, 0.0f}));
+}
+
 bool Guard::detectPlayer(const Player& player) {
-    if (detectionCooldown > 0) return false;
-    
-    float distance = distanceTo(player.getPosition());
-    
-    if (distance < detectionRadius) {
-        hasDetectedPlayer = true;
-        detectionCooldown = cooldownTime;
-        return true;
-    }
-    
-    hasDetectedPlayer = false;
-    return false;
+    return system->detectOne(slot, player.getPosition());
 }
 
 bool Guard::checkCollision(const sf::FloatRect& bounds) {
-    return sprite.getGlobalBounds().findIntersection(bounds).has_value();
+    return getBounds().findIntersection(bounds).has_value();
 }
 
+// Simulation position and size, independent of the sprite
 sf::FloatRect Guard::getBounds() const {
-    return sprite.getGlobalBounds();
+    return sf::FloatRect(getPosition(), CHARACTER_DISPLAY_SIZE);
 }
 
 sf::Vector2f Guard::getPosition() const {
-    return position;
+    return system->getPosition(slot);
+}
+
+float Guard::getDetectionRadius() const {
+    return system->getRadius(slot);
 }
 
 void Guard::setPosition(float x, float y) {
-    position = {x, y};
-    sprite.setPosition(position);
-    detectionCircle.setPosition(position);
+    sf::Vector2f oldPosition = getPosition();
+    system->setPosition(slot, {x, y}); // Teleport: nothing to blend from
+    syncIndex(oldPosition);
+    placeVisuals({x, y});
+}
+
+void Guard::savePreviousPosition() {
+    system->savePreviousPosition(slot);
+}
+
+void Guard::interpolate(float alpha) {
+    sf::Vector2f previous = system->getPreviousPosition(slot);
+    placeVisuals(previous + (system->getPosition(slot) - previous) * alpha);
+}
+
+// The cone's apex sits at the sprite's center, like the sight check's eyes
+void Guard::placeVisuals(const sf::Vector2f& shown) {
+    sprite.setPosition(shown);
+    detectionCone.setPosition(shown + CHARACTER_DISPLAY_SIZE / 2.0f);
+    sf::Vector2f heading = system->getHeading(slot);
+    detectionCone.setRotation(sf::radians(std::atan2(heading.y, heading.x)));
 }
 
 void Guard::update(float deltaTime, const Player& player) {
-    if (detectionCooldown > 0) {
-        detectionCooldown -= deltaTime;
-    }
-    patrol(deltaTime);
+    PROFILE_SCOPE("Guard::update");
+    sf::Vector2f oldPosition = getPosition();
+    system->updateOne(slot, deltaTime);
+    syncIndex(oldPosition);
 }
 
-void Guard::draw(sf::RenderWindow& window, bool showDetectionRadius) {
+void Guard::investigate(const sf::Vector2f& position) {
+    system->investigate(slot, position);
+}
+
+void Guard::draw(sf::RenderTarget& target, bool showDetectionRadius) {
     if (showDetectionRadius) {
-        window.draw(detectionCircle);
+        target.draw(detectionCone);
     }
-    window.draw(sprite);
+    target.draw(sprite);
 }
 
-float Guard::distanceTo(const sf::Vector2f& point) const {
-    float dx = point.x - position.x;
-    float dy = point.y - position.y;
-    return std::sqrt(dx * dx + dy * dy);
-}
\ No newline at end of file
+void Guard::draw(SpriteBatch& batch, bool showDetectionRadius) {
+    if (showDetectionRadius) {
+        batch.add(detectionCone);
+    }
+    batch.add(sprite);
+}
@@ -2,57 +2,73 @@
 #define GUARD_H
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <vector>
 
 class Player; // Forward declaration
+class SpriteBatch;
+class GuardSystem;
+template <typename T> class SpatialHash;
 
+// Guard - Handle to one slot of a GuardSystem, plus its visuals. Position,
+// patrol and detection state live in the system's arrays; a guard starts in
+// a private single-slot system and moves into its room's when added there.
 class Guard {
 private:
-    sf::Vector2f position;
+    // Simulation state
+    GuardSystem* system;
+    std::size_t slot;
+    std::unique_ptr<GuardSystem> ownSystem; // Until the guard joins a room
+
     sf::Sprite sprite; // CHANGED: Now a Sprite
-    float speed;
-    
-    // Patrol logic
-    std::vector<sf::Vector2f> patrolPoints;
-    int currentPatrolIndex;
-    bool movingForward;
-    
-    // Detection logic
-    float detectionRadius;
-    bool hasDetectedPlayer;
-    float detectionCooldown; // Time before guard can detect again
-    float cooldownTime;
-    
+
     // Visuals
-    sf::CircleShape detectionCircle;
+    sf::ConvexShape detectionCone; // Apex at the origin, pointing along +x
     sf::FloatRect roomBounds;
-    
+
+    // Owning room's guard index, kept in sync whenever position changes
+    SpatialHash<Guard>* spatialIndex;
+    void syncIndex(const sf::Vector2f& oldPosition);
+    void placeVisuals(const sf::Vector2f& shown);
+    void buildCone(float range);
+
 public:
     // Constructor - CHANGED: Takes Texture
     Guard(float x, float y, float detectionRange, const sf::Texture& texture);
-    
+    ~Guard();
+
     // Patrol management
     void addPatrolPoint(float x, float y);
     void setPatrolPoints(const std::vector<sf::Vector2f>& points);
     void setRoomBounds(const sf::FloatRect& bounds);
-    
-    // AI Logic
+    void setSpatialIndex(SpatialHash<Guard>* index);
+
+    // Move this guard's state into a (room's) system; returns its new slot
+    std::size_t joinSystem(GuardSystem& target);
+    GuardSystem& getSystem() const;
+    std::size_t getSlot() const;
+
+    // AI Logic (one guard; rooms step all of theirs with the batch kernels)
     void patrol(float deltaTime);
     bool detectPlayer(const Player& player);
     void update(float deltaTime, const Player& player);
-    
+    // Walk (around obstacles) to a position, then back to the patrol
+    void investigate(const sf::Vector2f& position);
+
     // Rendering
-    void draw(sf::RenderWindow& window, bool showDetectionRadius = true);
-    
+    void draw(sf::RenderTarget& target, bool showDetectionRadius = true);
+    void draw(SpriteBatch& batch, bool showDetectionRadius = true);
+
     // Utilities
     bool checkCollision(const sf::FloatRect& bounds);
     sf::FloatRect getBounds() const;
     sf::Vector2f getPosition() const;
     void setPosition(float x, float y);
-    
-private:
-    void moveTowards(const sf::Vector2f& target, float deltaTime);
-    float distanceTo(const sf::Vector2f& point) const;
+    float getDetectionRadius() const;
+
+    // Render interpolation (fixed-step simulation)
+    void savePreviousPosition();
+    void interpolate(float alpha);
 };
 
-#endif // GUARD_H
\ No newline at end of file
+#endif // GUARD_H
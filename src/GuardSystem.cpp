@@ -0,0 +1,708 @@
+/*
+ * Museum Escape - GuardSystem Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "GuardSystem.h"
+#include "PathService.h"
+#include "NavGrid.h"
+#include "FlowField.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#define GUARD_SYSTEM_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GUARD_SYSTEM_SSE 1
+#endif
+#if defined(GUARD_SYSTEM_AVX) || defined(GUARD_SYSTEM_SSE)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    // Closer than this to the patrol point counts as arrived (compared squared)
+    const float ARRIVE_DISTANCE_SQ = 5.0f * 5.0f;
+
+    // A target nearer than this gives no heading: the guard keeps its last
+    const float HEADING_EPSILON_SQ = 1e-4f;
+
+    // Vision cone, compared squared so no square roots are needed
+    const float VISION_COS = std::cos(GuardSystem::VISION_HALF_ANGLE * 3.14159265f / 180.0f);
+    const float VISION_COS_SQ = VISION_COS * VISION_COS;
+    const float NOTICE_DISTANCE_SQ = GuardSystem::NOTICE_DISTANCE * GuardSystem::NOTICE_DISTANCE;
+
+    // Index of the lowest set bit of a non-zero lane mask
+    inline int lowestLane(int bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, static_cast<unsigned long>(bits));
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(static_cast<unsigned>(bits));
+#endif
+    }
+}
+
+GuardSystem::GuardSystem()
+    : paths(nullptr),
+      converging(false),
+      occluders(nullptr),
+      eyeOffset(0.0f, 0.0f),
+      sightCaching(true),
+      raycastCount(0),
+      kernel(bestKernel()) {}
+
+GuardSystem::Kernel GuardSystem::bestKernel() {
+#if defined(GUARD_SYSTEM_AVX)
+    return Kernel::AVX;
+#elif defined(GUARD_SYSTEM_SSE)
+    return Kernel::SSE;
+#else
+    return Kernel::SCALAR;
+#endif
+}
+
+void GuardSystem::setKernel(Kernel k) { kernel = std::min(k, bestKernel()); }
+GuardSystem::Kernel GuardSystem::getKernel() const { return kernel; }
+
+const char* GuardSystem::kernelName(Kernel k) {
+    switch (k) {
+        case Kernel::AVX: return "AVX";
+        case Kernel::SSE: return "SSE";
+        default: return "scalar";
+    }
+}
+
+// ============================================================================
+// Slots
+// ============================================================================
+
+std::size_t GuardSystem::add(const sf::Vector2f& position, float moveSpeed, float detectionRadius, float detectionCooldown) {
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    prevX.push_back(position.x);
+    prevY.push_back(position.y);
+    targetX.push_back(position.x); // No patrol yet: already "at" the target
+    targetY.push_back(position.y);
+    headingX.push_back(1.0f); // Facing right until it first moves
+    headingY.push_back(0.0f);
+    speed.push_back(moveSpeed);
+    radius.push_back(detectionRadius);
+    radiusSq.push_back(detectionRadius * detectionRadius);
+    cooldown.push_back(0.0f);
+    cooldownTime.push_back(detectionCooldown);
+    patrolIndex.push_back(0);
+    patrolDirection.push_back(1);
+    patrolStart.push_back(static_cast<std::uint32_t>(patrolX.size()));
+    patrolCount.push_back(0);
+    route.emplace_back();
+    routeIndex.push_back(0);
+    pathTicket.push_back(PathService::NO_TICKET);
+    goalX.push_back(position.x);
+    goalY.push_back(position.y);
+    investigating.push_back(0);
+    sightGuardCell.push_back(-1);
+    sightPlayerCell.push_back(-1);
+    sightClear.push_back(0);
+    return posX.size() - 1;
+}
+
+std::size_t GuardSystem::adopt(const GuardSystem& other, std::size_t otherSlot) {
+    std::size_t slot = add(other.getPosition(otherSlot), other.speed[otherSlot],
+                           other.radius[otherSlot], other.cooldownTime[otherSlot]);
+    setPatrol(slot, other.getPatrol(otherSlot));
+
+    // Then the exact dynamic state (setPatrol resets some of it)
+    posX[slot] = other.posX[otherSlot];
+    posY[slot] = other.posY[otherSlot];
+    prevX[slot] = other.prevX[otherSlot];
+    prevY[slot] = other.prevY[otherSlot];
+    cooldown[slot] = other.cooldown[otherSlot];
+    patrolIndex[slot] = other.patrolIndex[otherSlot];
+    patrolDirection[slot] = other.patrolDirection[otherSlot];
+    targetX[slot] = other.targetX[otherSlot];
+    targetY[slot] = other.targetY[otherSlot];
+    headingX[slot] = other.headingX[otherSlot];
+    headingY[slot] = other.headingY[otherSlot];
+
+    // Routes belong to the other system's room; plan this leg afresh here
+    if (paths && patrolCount[slot] > 1) headTo(slot, {targetX[slot], targetY[slot]});
+    return slot;
+}
+
+// Routes are appended to the shared arrays; a shorter replacement reuses
+// the old space. Routes are set while building a room, so the waste of a
+// longer replacement does not matter.
+void GuardSystem::setPatrol(std::size_t slot, const std::vector<sf::Vector2f>& points) {
+    if (points.size() > patrolCount[slot]) {
+        patrolStart[slot] = static_cast<std::uint32_t>(patrolX.size());
+        patrolX.resize(patrolX.size() + points.size());
+        patrolY.resize(patrolY.size() + points.size());
+    }
+    for (std::size_t i = 0; i < points.size(); i++) {
+        patrolX[patrolStart[slot] + i] = points[i].x;
+        patrolY[patrolStart[slot] + i] = points[i].y;
+    }
+    patrolCount[slot] = static_cast<std::uint32_t>(points.size());
+    patrolIndex[slot] = 0;
+    patrolDirection[slot] = 1;
+
+    // A single point pins the guard there
+    if (points.size() == 1) setPosition(slot, points[0]);
+    refreshTarget(slot);
+}
+
+void GuardSystem::reserve(std::size_t guards) {
+    for (auto* column : {&posX, &posY, &prevX, &prevY, &targetX, &targetY, &headingX, &headingY, &speed, &radius, &radiusSq, &cooldown, &cooldownTime}) {
+        column->reserve(guards);
+    }
+    patrolIndex.reserve(guards);
+    patrolDirection.reserve(guards);
+    patrolStart.reserve(guards);
+    patrolCount.reserve(guards);
+    for (auto* column : {&goalX, &goalY}) column->reserve(guards);
+    route.reserve(guards);
+    routeIndex.reserve(guards);
+    pathTicket.reserve(guards);
+    investigating.reserve(guards);
+    sightGuardCell.reserve(guards);
+    sightPlayerCell.reserve(guards);
+    sightClear.reserve(guards);
+}
+
+void GuardSystem::setNavigation(PathService* service) { paths = service; }
+
+void GuardSystem::setOccluders(const NavGrid* grid, const sf::Vector2f& offset) {
+    occluders = grid;
+    eyeOffset = offset;
+    std::fill(sightGuardCell.begin(), sightGuardCell.end(), -1);
+    std::fill(sightPlayerCell.begin(), sightPlayerCell.end(), -1);
+}
+
+void GuardSystem::setSightCaching(bool enabled) {
+    sightCaching = enabled;
+    std::fill(sightGuardCell.begin(), sightGuardCell.end(), -1);
+}
+
+std::size_t GuardSystem::getRaycastCount() const { return raycastCount; }
+
+void GuardSystem::clear() {
+    for (auto* column : {&posX, &posY, &prevX, &prevY, &targetX, &targetY, &headingX, &headingY, &speed, &radius, &radiusSq, &cooldown, &cooldownTime, &patrolX, &patrolY}) {
+        column->clear();
+    }
+    patrolIndex.clear();
+    patrolDirection.clear();
+    patrolStart.clear();
+    patrolCount.clear();
+    for (std::uint32_t ticket : pathTicket) {
+        if (paths) paths->cancel(ticket);
+    }
+    for (auto* column : {&goalX, &goalY}) column->clear();
+    route.clear();
+    routeIndex.clear();
+    pathTicket.clear();
+    investigating.clear();
+    sightGuardCell.clear();
+    sightPlayerCell.clear();
+    sightClear.clear();
+}
+
+std::size_t GuardSystem::size() const { return posX.size(); }
+
+void GuardSystem::refreshTarget(std::size_t slot) {
+    if (patrolCount[slot] == 0) {
+        targetX[slot] = posX[slot];
+        targetY[slot] = posY[slot];
+        return;
+    }
+    std::size_t point = patrolStart[slot] + patrolIndex[slot];
+    targetX[slot] = patrolX[point];
+    targetY[slot] = patrolY[point];
+}
+
+// Ping-pong along the route: 0, 1, ..., n-1, n-2, ..., 0, 1, ...
+void GuardSystem::advancePatrol(std::size_t slot) {
+    std::int32_t count = static_cast<std::int32_t>(patrolCount[slot]);
+    if (count == 0) {
+        refreshTarget(slot); // Stay put, even after a teleport
+        return;
+    }
+    if (count == 1) {
+        posX[slot] = targetX[slot];
+        posY[slot] = targetY[slot];
+        return;
+    }
+
+    std::int32_t index = patrolIndex[slot] + patrolDirection[slot];
+    if (index >= count) {
+        index = count - 2;
+        patrolDirection[slot] = -1;
+    } else if (index < 0) {
+        index = 1;
+        patrolDirection[slot] = 1;
+    }
+    patrolIndex[slot] = index;
+    std::size_t point = patrolStart[slot] + index;
+    headTo(slot, {patrolX[point], patrolY[point]});
+}
+
+// ============================================================================
+// Navigation
+// ============================================================================
+
+// Reached the target: the next waypoint of the leg, else the next leg
+void GuardSystem::arrive(std::size_t slot) {
+    if (pathTicket[slot] != PathService::NO_TICKET) {
+        if (collectPath(slot)) nextWaypoint(slot);
+        return;
+    }
+    if (routeIndex[slot] < route[slot].size()) {
+        nextWaypoint(slot);
+        return;
+    }
+    if (investigating[slot]) {
+        // Back to the patrol point the guard was heading for
+        investigating[slot] = 0;
+        if (patrolCount[slot] > 0) {
+            std::size_t point = patrolStart[slot] + patrolIndex[slot];
+            headTo(slot, {patrolX[point], patrolY[point]});
+            return;
+        }
+    }
+    advancePatrol(slot);
+}
+
+// Straight at the goal when nothing is in the way, else ask for a path
+void GuardSystem::headTo(std::size_t slot, const sf::Vector2f& goal) {
+    if (paths) paths->cancel(pathTicket[slot]);
+    pathTicket[slot] = PathService::NO_TICKET;
+    route[slot].clear();
+    routeIndex[slot] = 0;
+    goalX[slot] = goal.x;
+    goalY[slot] = goal.y;
+
+    sf::Vector2f position(posX[slot], posY[slot]);
+    if (!paths || !paths->getGrid() || paths->getGrid()->lineOfSight(position, goal)) {
+        targetX[slot] = goal.x;
+        targetY[slot] = goal.y;
+        return;
+    }
+    pathTicket[slot] = paths->request(position, goal);
+    if (collectPath(slot)) nextWaypoint(slot); // Cached legs are ready at once
+}
+
+// Hold still while the search runs; no path means walk straight after all
+bool GuardSystem::collectPath(std::size_t slot) {
+    PathService::Status status = paths->poll(pathTicket[slot], route[slot]);
+    if (status == PathService::Status::PENDING) {
+        targetX[slot] = posX[slot];
+        targetY[slot] = posY[slot];
+        return false;
+    }
+    pathTicket[slot] = PathService::NO_TICKET;
+    routeIndex[slot] = 0;
+    if (status != PathService::Status::READY) route[slot].assign(1, {goalX[slot], goalY[slot]});
+    return true;
+}
+
+void GuardSystem::nextWaypoint(std::size_t slot) {
+    const sf::Vector2f& waypoint = route[slot][routeIndex[slot]++];
+    targetX[slot] = waypoint.x;
+    targetY[slot] = waypoint.y;
+}
+
+void GuardSystem::investigate(std::size_t slot, const sf::Vector2f& position) {
+    investigating[slot] = 1;
+    headTo(slot, position);
+}
+
+bool GuardSystem::isInvestigating(std::size_t slot) const { return investigating[slot] != 0; }
+
+// One table lookup per guard: the cost does not depend on how many share the field
+void GuardSystem::converge(const FlowField& field, const sf::Vector2f& goal) {
+    converging = true;
+    for (std::size_t slot = 0; slot < size(); slot++) {
+        sf::Vector2f waypoint;
+        if (!field.step({posX[slot], posY[slot]}, waypoint)) waypoint = goal;
+        targetX[slot] = waypoint.x;
+        targetY[slot] = waypoint.y;
+    }
+}
+
+void GuardSystem::endConverge() {
+    if (!converging) return;
+    converging = false;
+    for (std::size_t slot = 0; slot < size(); slot++) {
+        investigating[slot] = 0;
+        if (patrolCount[slot] == 0) {
+            refreshTarget(slot);
+            continue;
+        }
+        std::size_t point = patrolStart[slot] + patrolIndex[slot];
+        headTo(slot, {patrolX[point], patrolY[point]});
+    }
+}
+
+bool GuardSystem::isConverging() const { return converging; }
+
+// ============================================================================
+// Batch kernels
+// ============================================================================
+
+void GuardSystem::savePreviousPositions() {
+    std::copy(posX.begin(), posX.end(), prevX.begin());
+    std::copy(posY.begin(), posY.end(), prevY.begin());
+}
+
+void GuardSystem::update(float deltaTime) {
+    PROFILE_SCOPE("GuardSystem::update");
+    arrived.clear();
+    std::size_t count = size();
+    switch (kernel) {
+        case Kernel::AVX: stepAvx(0, count, deltaTime); break;
+        case Kernel::SSE: stepSse(0, count, deltaTime); break;
+        default: stepScalar(0, count, deltaTime); break;
+    }
+    // Arrivals are rare and branchy; handle them one by one. Converging
+    // guards that arrive are on the intruder: they stay there.
+    if (!converging) {
+        for (std::uint32_t slot : arrived) arrive(slot);
+    }
+    updateHeadings(0, count);
+}
+
+// After the targets are final for the tick, so a guard turns as it arrives
+void GuardSystem::updateHeadings(std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+        float dx = targetX[i] - posX[i];
+        float dy = targetY[i] - posY[i];
+        if (dx * dx + dy * dy > HEADING_EPSILON_SQ) {
+            headingX[i] = dx;
+            headingY[i] = dy;
+        }
+    }
+}
+
+// Reference kernel. The SIMD versions do exactly this per lane:
+// cooldown tick, then either arrive (no movement this tick) or take one
+// step of length speed * dt towards the target.
+void GuardSystem::stepScalar(std::size_t begin, std::size_t end, float deltaTime) {
+    for (std::size_t i = begin; i < end; i++) {
+        cooldown[i] = cooldown[i] - (cooldown[i] > 0.0f ? deltaTime : 0.0f);
+
+        float dx = targetX[i] - posX[i];
+        float dy = targetY[i] - posY[i];
+        float distanceSq = dx * dx + dy * dy;
+        if (distanceSq < ARRIVE_DISTANCE_SQ) {
+            arrived.push_back(static_cast<std::uint32_t>(i));
+            continue;
+        }
+        float distance = std::sqrt(distanceSq);
+        posX[i] = posX[i] + ((dx / distance) * speed[i]) * deltaTime;
+        posY[i] = posY[i] + ((dy / distance) * speed[i]) * deltaTime;
+    }
+}
+
+void GuardSystem::stepSse(std::size_t begin, std::size_t end, float deltaTime) {
+#if defined(GUARD_SYSTEM_SSE)
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 arriveSq = _mm_set1_ps(ARRIVE_DISTANCE_SQ);
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 cd = _mm_loadu_ps(&cooldown[i]);
+        cd = _mm_sub_ps(cd, _mm_and_ps(dt, _mm_cmpgt_ps(cd, zero)));
+        _mm_storeu_ps(&cooldown[i], cd);
+
+        __m128 px = _mm_loadu_ps(&posX[i]);
+        __m128 py = _mm_loadu_ps(&posY[i]);
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&targetX[i]), px);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&targetY[i]), py);
+        __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 arrivedMask = _mm_cmplt_ps(distanceSq, arriveSq);
+
+        __m128 distance = _mm_sqrt_ps(distanceSq);
+        __m128 s = _mm_loadu_ps(&speed[i]);
+        __m128 nextX = _mm_add_ps(px, _mm_mul_ps(_mm_mul_ps(_mm_div_ps(dx, distance), s), dt));
+        __m128 nextY = _mm_add_ps(py, _mm_mul_ps(_mm_mul_ps(_mm_div_ps(dy, distance), s), dt));
+        // Arrived lanes keep their position (and discard the 0/0 above)
+        _mm_storeu_ps(&posX[i], _mm_or_ps(_mm_and_ps(arrivedMask, px), _mm_andnot_ps(arrivedMask, nextX)));
+        _mm_storeu_ps(&posY[i], _mm_or_ps(_mm_and_ps(arrivedMask, py), _mm_andnot_ps(arrivedMask, nextY)));
+
+        int bits = _mm_movemask_ps(arrivedMask);
+        while (bits) {
+            int lane = lowestLane(bits);
+            arrived.push_back(static_cast<std::uint32_t>(i + lane));
+            bits &= bits - 1;
+        }
+    }
+    stepScalar(i, end, deltaTime);
+#else
+    stepScalar(begin, end, deltaTime);
+#endif
+}
+
+void GuardSystem::stepAvx(std::size_t begin, std::size_t end, float deltaTime) {
+#if defined(GUARD_SYSTEM_AVX)
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 arriveSq = _mm256_set1_ps(ARRIVE_DISTANCE_SQ);
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 cd = _mm256_loadu_ps(&cooldown[i]);
+        cd = _mm256_sub_ps(cd, _mm256_and_ps(dt, _mm256_cmp_ps(cd, zero, _CMP_GT_OQ)));
+        _mm256_storeu_ps(&cooldown[i], cd);
+
+        __m256 px = _mm256_loadu_ps(&posX[i]);
+        __m256 py = _mm256_loadu_ps(&posY[i]);
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&targetX[i]), px);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&targetY[i]), py);
+        __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 arrivedMask = _mm256_cmp_ps(distanceSq, arriveSq, _CMP_LT_OQ);
+
+        __m256 distance = _mm256_sqrt_ps(distanceSq);
+        __m256 s = _mm256_loadu_ps(&speed[i]);
+        __m256 nextX = _mm256_add_ps(px, _mm256_mul_ps(_mm256_mul_ps(_mm256_div_ps(dx, distance), s), dt));
+        __m256 nextY = _mm256_add_ps(py, _mm256_mul_ps(_mm256_mul_ps(_mm256_div_ps(dy, distance), s), dt));
+        _mm256_storeu_ps(&posX[i], _mm256_blendv_ps(nextX, px, arrivedMask));
+        _mm256_storeu_ps(&posY[i], _mm256_blendv_ps(nextY, py, arrivedMask));
+
+        int bits = _mm256_movemask_ps(arrivedMask);
+        while (bits) {
+            int lane = lowestLane(bits);
+            arrived.push_back(static_cast<std::uint32_t>(i + lane));
+            bits &= bits - 1;
+        }
+    }
+    stepSse(i, end, deltaTime);
+#else
+    stepSse(begin, end, deltaTime);
+#endif
+}
+
+bool GuardSystem::detectsScalar(std::size_t slot, float playerX, float playerY) const {
+    float dx = playerX - posX[slot];
+    float dy = playerY - posY[slot];
+    return !(cooldown[slot] > 0.0f) && dx * dx + dy * dy < radiusSq[slot];
+}
+
+// Inside the cone: angle to the heading at most the half angle, i.e.
+// along >= cos * |heading| * |d|, squared (along is positive: cos > 0)
+bool GuardSystem::sees(std::size_t slot, float playerX, float playerY) {
+    float dx = playerX - posX[slot];
+    float dy = playerY - posY[slot];
+    float distanceSq = dx * dx + dy * dy;
+    if (!(distanceSq < NOTICE_DISTANCE_SQ)) {
+        float along = dx * headingX[slot] + dy * headingY[slot];
+        float headingSq = headingX[slot] * headingX[slot] + headingY[slot] * headingY[slot];
+        if (!(along > 0.0f) || along * along < VISION_COS_SQ * headingSq * distanceSq) return false;
+    }
+    return clearSight(slot, playerX, playerY);
+}
+
+// DDA over the occluder grid, from eyes to the player's center. Reused
+// while neither end leaves its cell: a cell-sized approximation that
+// turns most checks into two compares.
+bool GuardSystem::clearSight(std::size_t slot, float playerX, float playerY) {
+    if (!occluders || !occluders->hasObstacles()) return true;
+    sf::Vector2f eye(posX[slot] + eyeOffset.x, posY[slot] + eyeOffset.y);
+    sf::Vector2f seen(playerX + eyeOffset.x, playerY + eyeOffset.y);
+    std::int32_t guardCell = occluders->cellAt(eye);
+    std::int32_t playerCell = occluders->cellAt(seen);
+    if (sightCaching && sightGuardCell[slot] == guardCell && sightPlayerCell[slot] == playerCell) return sightClear[slot] != 0;
+
+    raycastCount++;
+    bool clear = occluders->lineOfSight(eye, seen);
+    sightGuardCell[slot] = guardCell;
+    sightPlayerCell[slot] = playerCell;
+    sightClear[slot] = clear ? 1 : 0;
+    return clear;
+}
+
+void GuardSystem::detect(const sf::Vector2f& playerPosition, std::vector<std::size_t>& hits) {
+    hits.clear();
+    std::size_t count = size();
+    std::size_t i = 0;
+
+#if defined(GUARD_SYSTEM_AVX)
+    if (kernel == Kernel::AVX) {
+        const __m256 playerX = _mm256_set1_ps(playerPosition.x);
+        const __m256 playerY = _mm256_set1_ps(playerPosition.y);
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            __m256 dx = _mm256_sub_ps(playerX, _mm256_loadu_ps(&posX[i]));
+            __m256 dy = _mm256_sub_ps(playerY, _mm256_loadu_ps(&posY[i]));
+            __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 inRange = _mm256_cmp_ps(distanceSq, _mm256_loadu_ps(&radiusSq[i]), _CMP_LT_OQ);
+            __m256 ready = _mm256_cmp_ps(_mm256_loadu_ps(&cooldown[i]), zero, _CMP_NGT_UQ);
+            int bits = _mm256_movemask_ps(_mm256_and_ps(inRange, ready));
+            while (bits) {
+                hits.push_back(i + lowestLane(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+#endif
+#if defined(GUARD_SYSTEM_SSE)
+    if (kernel != Kernel::SCALAR) {
+        const __m128 playerX = _mm_set1_ps(playerPosition.x);
+        const __m128 playerY = _mm_set1_ps(playerPosition.y);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 dx = _mm_sub_ps(playerX, _mm_loadu_ps(&posX[i]));
+            __m128 dy = _mm_sub_ps(playerY, _mm_loadu_ps(&posY[i]));
+            __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 inRange = _mm_cmplt_ps(distanceSq, _mm_loadu_ps(&radiusSq[i]));
+            __m128 ready = _mm_cmpngt_ps(_mm_loadu_ps(&cooldown[i]), zero);
+            int bits = _mm_movemask_ps(_mm_and_ps(inRange, ready));
+            while (bits) {
+                hits.push_back(i + lowestLane(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (detectsScalar(i, playerPosition.x, playerPosition.y)) hits.push_back(i);
+    }
+
+    finishDetect(playerPosition, hits);
+}
+
+// The same kernels over a broadphase's candidate slots, gathered lane by
+// lane. Candidates are taken in the given order (sorted slots keep the
+// hits in the same order as a full detect()).
+void GuardSystem::detect(const sf::Vector2f& playerPosition, const std::vector<std::size_t>& candidates,
+                         std::vector<std::size_t>& hits) {
+    hits.clear();
+    std::size_t count = candidates.size();
+    const std::size_t* c = candidates.data();
+    std::size_t i = 0;
+
+#if defined(GUARD_SYSTEM_AVX)
+    if (kernel == Kernel::AVX) {
+        const __m256 playerX = _mm256_set1_ps(playerPosition.x);
+        const __m256 playerY = _mm256_set1_ps(playerPosition.y);
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_setr_ps(posX[c[i]], posX[c[i + 1]], posX[c[i + 2]], posX[c[i + 3]],
+                                      posX[c[i + 4]], posX[c[i + 5]], posX[c[i + 6]], posX[c[i + 7]]);
+            __m256 y = _mm256_setr_ps(posY[c[i]], posY[c[i + 1]], posY[c[i + 2]], posY[c[i + 3]],
+                                      posY[c[i + 4]], posY[c[i + 5]], posY[c[i + 6]], posY[c[i + 7]]);
+            __m256 r = _mm256_setr_ps(radiusSq[c[i]], radiusSq[c[i + 1]], radiusSq[c[i + 2]], radiusSq[c[i + 3]],
+                                      radiusSq[c[i + 4]], radiusSq[c[i + 5]], radiusSq[c[i + 6]], radiusSq[c[i + 7]]);
+            __m256 wait = _mm256_setr_ps(cooldown[c[i]], cooldown[c[i + 1]], cooldown[c[i + 2]], cooldown[c[i + 3]],
+                                         cooldown[c[i + 4]], cooldown[c[i + 5]], cooldown[c[i + 6]], cooldown[c[i + 7]]);
+            __m256 dx = _mm256_sub_ps(playerX, x);
+            __m256 dy = _mm256_sub_ps(playerY, y);
+            __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 inRange = _mm256_cmp_ps(distanceSq, r, _CMP_LT_OQ);
+            __m256 ready = _mm256_cmp_ps(wait, zero, _CMP_NGT_UQ);
+            int bits = _mm256_movemask_ps(_mm256_and_ps(inRange, ready));
+            while (bits) {
+                hits.push_back(c[i + lowestLane(bits)]);
+                bits &= bits - 1;
+            }
+        }
+    }
+#endif
+#if defined(GUARD_SYSTEM_SSE)
+    if (kernel != Kernel::SCALAR) {
+        const __m128 playerX = _mm_set1_ps(playerPosition.x);
+        const __m128 playerY = _mm_set1_ps(playerPosition.y);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_setr_ps(posX[c[i]], posX[c[i + 1]], posX[c[i + 2]], posX[c[i + 3]]);
+            __m128 y = _mm_setr_ps(posY[c[i]], posY[c[i + 1]], posY[c[i + 2]], posY[c[i + 3]]);
+            __m128 r = _mm_setr_ps(radiusSq[c[i]], radiusSq[c[i + 1]], radiusSq[c[i + 2]], radiusSq[c[i + 3]]);
+            __m128 wait = _mm_setr_ps(cooldown[c[i]], cooldown[c[i + 1]], cooldown[c[i + 2]], cooldown[c[i + 3]]);
+            __m128 dx = _mm_sub_ps(playerX, x);
+            __m128 dy = _mm_sub_ps(playerY, y);
+            __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 inRange = _mm_cmplt_ps(distanceSq, r);
+            __m128 ready = _mm_cmpngt_ps(wait, zero);
+            int bits = _mm_movemask_ps(_mm_and_ps(inRange, ready));
+            while (bits) {
+                hits.push_back(c[i + lowestLane(bits)]);
+                bits &= bits - 1;
+            }
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (detectsScalar(c[i], playerPosition.x, playerPosition.y)) hits.push_back(c[i]);
+    }
+
+    finishDetect(playerPosition, hits);
+}
+
+// Narrow phase, only for the few in range: cone, then line of sight
+void GuardSystem::finishDetect(const sf::Vector2f& playerPosition, std::vector<std::size_t>& hits) {
+    std::size_t kept = 0;
+    for (std::size_t slot : hits) {
+        if (sees(slot, playerPosition.x, playerPosition.y)) hits[kept++] = slot;
+    }
+    hits.resize(kept);
+
+    // Each guard that saw the player waits before it can detect again
+    for (std::size_t slot : hits) cooldown[slot] = cooldownTime[slot];
+}
+
+// ============================================================================
+// Single guard
+// ============================================================================
+
+void GuardSystem::updateOne(std::size_t slot, float deltaTime) {
+    arrived.clear();
+    stepScalar(slot, slot + 1, deltaTime);
+    if (!arrived.empty() && !converging) arrive(slot);
+    updateHeadings(slot, slot + 1);
+}
+
+// Patrol only: the cooldown is left alone
+void GuardSystem::patrolOne(std::size_t slot, float deltaTime) {
+    float savedCooldown = cooldown[slot];
+    updateOne(slot, deltaTime);
+    cooldown[slot] = savedCooldown;
+}
+
+bool GuardSystem::detectOne(std::size_t slot, const sf::Vector2f& playerPosition) {
+    if (!detectsScalar(slot, playerPosition.x, playerPosition.y)) return false;
+    if (!sees(slot, playerPosition.x, playerPosition.y)) return false;
+    cooldown[slot] = cooldownTime[slot];
+    return true;
+}
+
+sf::Vector2f GuardSystem::getPosition(std::size_t slot) const { return {posX[slot], posY[slot]}; }
+sf::Vector2f GuardSystem::getPreviousPosition(std::size_t slot) const { return {prevX[slot], prevY[slot]}; }
+
+void GuardSystem::setPosition(std::size_t slot, const sf::Vector2f& position) {
+    posX[slot] = prevX[slot] = position.x;
+    posY[slot] = prevY[slot] = position.y;
+    if (patrolCount[slot] == 0) refreshTarget(slot);
+}
+
+void GuardSystem::savePreviousPosition(std::size_t slot) {
+    prevX[slot] = posX[slot];
+    prevY[slot] = posY[slot];
+}
+
+float GuardSystem::getRadius(std::size_t slot) const { return radius[slot]; }
+float GuardSystem::getSpeed(std::size_t slot) const { return speed[slot]; }
+float GuardSystem::getCooldownTime(std::size_t slot) const { return cooldownTime[slot]; }
+sf::Vector2f GuardSystem::getHeading(std::size_t slot) const { return {headingX[slot], headingY[slot]}; }
+
+std::vector<sf::Vector2f> GuardSystem::getPatrol(std::size_t slot) const {
+    std::vector<sf::Vector2f> points;
+    for (std::uint32_t i = 0; i < patrolCount[slot]; i++) {
+        points.push_back({patrolX[patrolStart[slot] + i], patrolY[patrolStart[slot] + i]});
+    }
+    return points;
+}
@@ -0,0 +1,165 @@
+#ifndef GUARD_SYSTEM_H
+#define GUARD_SYSTEM_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PathService;
+class FlowField;
+class NavGrid;
+
+// GuardSystem - Simulation state of a room's guards as parallel arrays
+// (structure of arrays). Patrol stepping and player detection run as batch
+// kernels over the arrays: AVX (8 lanes) or SSE (4 lanes) when the build
+// targets them, with a scalar fallback. Every path performs the same IEEE
+// operations in the same order, so results are bit-identical whichever
+// kernel runs and replays stay exact.
+//
+// Legs that an obstacle blocks go through the room's PathService: the
+// guard holds still until its path is ready, then walks the waypoints.
+// Unobstructed legs (every leg in a room without obstacles) head straight
+// for the point, as they always have. While converging (an alarm), every
+// guard instead steps down one shared flow field towards the intruder.
+//
+// Detection is a vision cone: in range (the batch kernels), within
+// VISION_HALF_ANGLE of the guard's heading (or right beside it), and with
+// a clear line of sight over the room's occluder grid. The raycast result
+// is cached per guard and only redone when the guard or the player moves
+// to another occluder cell.
+//
+// Guard objects are handles into a system (slot index) that add sprites
+// and the authoring API on top.
+class GuardSystem {
+public:
+    static constexpr float VISION_HALF_ANGLE = 60.0f; // Degrees either side of the heading
+    static constexpr float NOTICE_DISTANCE = 30.0f;   // Closer than this is seen from any side
+
+    enum class Kernel {
+        SCALAR,
+        SSE,
+        AVX
+    };
+
+private:
+    // Per-guard state, one entry per slot
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;       // Position at the start of the tick
+    std::vector<float> targetX, targetY;   // Current patrol point, cached
+    std::vector<float> headingX, headingY; // Facing: towards the target (unnormalized), kept while still
+    std::vector<float> speed;
+    std::vector<float> radius;
+    std::vector<float> radiusSq;
+    std::vector<float> cooldown;           // Time before the guard can detect again
+    std::vector<float> cooldownTime;
+    std::vector<std::int32_t> patrolIndex;
+    std::vector<std::int32_t> patrolDirection; // +1 forward, -1 back
+    std::vector<std::uint32_t> patrolStart;    // Offset into patrolX/patrolY
+    std::vector<std::uint32_t> patrolCount;
+
+    // All patrol routes back to back
+    std::vector<float> patrolX, patrolY;
+
+    // Navigation: the leg being walked and where it ends
+    std::vector<std::vector<sf::Vector2f>> route; // Waypoints; empty for a straight leg
+    std::vector<std::uint32_t> routeIndex;         // Next waypoint to head for
+    std::vector<std::uint32_t> pathTicket;         // Outstanding request (PathService::NO_TICKET: none)
+    std::vector<float> goalX, goalY;
+    std::vector<std::uint8_t> investigating;       // Off patrol, heading for a sighting
+
+    PathService* paths; // Room's path service (optional)
+    bool converging;    // Targets come from converge(), not the patrol
+
+    // Line of sight: occluder cells of the last raycast and its result
+    std::vector<std::int32_t> sightGuardCell, sightPlayerCell; // -1: none yet
+    std::vector<std::uint8_t> sightClear;
+    const NavGrid* occluders; // Room's occluder grid (optional: nothing occludes)
+    sf::Vector2f eyeOffset;   // From a position to the eyes (and the player's center)
+    bool sightCaching;
+    std::size_t raycastCount;
+
+    // Guards that reached their patrol point this tick (filled by the kernels)
+    std::vector<std::uint32_t> arrived;
+
+    Kernel kernel;
+
+    void stepScalar(std::size_t begin, std::size_t end, float deltaTime);
+    void stepSse(std::size_t begin, std::size_t end, float deltaTime);
+    void stepAvx(std::size_t begin, std::size_t end, float deltaTime);
+    void advancePatrol(std::size_t slot);
+    void refreshTarget(std::size_t slot);
+    void arrive(std::size_t slot);
+    void headTo(std::size_t slot, const sf::Vector2f& goal);
+    bool collectPath(std::size_t slot); // False while the path is still pending
+    void nextWaypoint(std::size_t slot);
+
+    bool detectsScalar(std::size_t slot, float playerX, float playerY) const;
+    bool sees(std::size_t slot, float playerX, float playerY); // Cone and line of sight
+    bool clearSight(std::size_t slot, float playerX, float playerY);
+    void finishDetect(const sf::Vector2f& playerPosition, std::vector<std::size_t>& hits);
+    void updateHeadings(std::size_t begin, std::size_t end);
+
+public:
+    // Constructor - starts on the widest kernel this build supports
+    GuardSystem();
+
+    static Kernel bestKernel();
+    void setKernel(Kernel k); // Clamped to what the build supports
+    Kernel getKernel() const;
+    static const char* kernelName(Kernel k);
+
+    // Slots
+    std::size_t add(const sf::Vector2f& position, float moveSpeed, float detectionRadius, float detectionCooldown);
+    std::size_t adopt(const GuardSystem& other, std::size_t otherSlot); // Copy a guard from another system
+    void setPatrol(std::size_t slot, const std::vector<sf::Vector2f>& points);
+    void reserve(std::size_t guards);
+    // Route blocked legs through this service (null: always straight)
+    void setNavigation(PathService* service);
+    // Sight is blocked by this grid's cells, traced between the two
+    // characters' positions plus offset (null: nothing occludes).
+    // Forgets every cached raycast.
+    void setOccluders(const NavGrid* grid, const sf::Vector2f& offset);
+    void setSightCaching(bool enabled); // For benchmarks: raycast every check
+    std::size_t getRaycastCount() const;
+    void clear();
+    std::size_t size() const;
+
+    // Batch kernels
+    void savePreviousPositions();
+    void update(float deltaTime);  // Cooldowns and patrol for every guard
+    // Slots of guards that see the player (and start their cooldown)
+    void detect(const sf::Vector2f& playerPosition, std::vector<std::size_t>& hits);
+    // Same, checking only these slots (a broadphase's candidates)
+    void detect(const sf::Vector2f& playerPosition, const std::vector<std::size_t>& candidates,
+                std::vector<std::size_t>& hits);
+
+    // Single guard, same arithmetic as the batch kernels
+    void updateOne(std::size_t slot, float deltaTime);
+    void patrolOne(std::size_t slot, float deltaTime);
+    bool detectOne(std::size_t slot, const sf::Vector2f& playerPosition);
+
+    // Leave the patrol to check a position, then resume where it left off
+    void investigate(std::size_t slot, const sf::Vector2f& position);
+    bool isInvestigating(std::size_t slot) const;
+
+    // Alarm: aim every guard at the next cell down the field (straight at
+    // goal in its cell, or where the field does not reach). Call before each
+    // update while it lasts; endConverge() sends everyone back to patrol.
+    void converge(const FlowField& field, const sf::Vector2f& goal);
+    void endConverge();
+    bool isConverging() const;
+
+    // Per-guard access
+    sf::Vector2f getPosition(std::size_t slot) const;
+    sf::Vector2f getPreviousPosition(std::size_t slot) const;
+    void setPosition(std::size_t slot, const sf::Vector2f& position); // Teleport: previous = position
+    void savePreviousPosition(std::size_t slot);
+    float getRadius(std::size_t slot) const;
+    float getSpeed(std::size_t slot) const;
+    float getCooldownTime(std::size_t slot) const;
+    sf::Vector2f getHeading(std::size_t slot) const; // Unnormalized
+    std::vector<sf::Vector2f> getPatrol(std::size_t slot) const;
+};
+
+#endif // GUARD_SYSTEM_H
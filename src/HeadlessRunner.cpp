@@ -0,0 +1,126 @@
+/*
+ * Museum Escape - Headless Runner Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "HeadlessRunner.h"
+#include <chrono>
+
+namespace {
+    // Walk pattern: each leg is held for LEG_TICKS, cycling through LEGS
+    const unsigned long long LEG_TICKS = 90;
+    const int LEG_COUNT = 6;
+    const PlayerInput LEGS[LEG_COUNT] = {
+        {false, false, false, true},  // right
+        {false, true, false, true},   // down-right
+        {false, true, false, false},  // down
+        {false, false, true, false},  // left
+        {true, false, true, false},   // up-left
+        {true, false, false, false},  // up
+    };
+
+    const unsigned long long INTERACT_EVERY = 45;  // E: doors and items
+    const unsigned long long PUZZLE_EVERY = 400;   // P: open a puzzle...
+    const unsigned long long PUZZLE_TICKS = 30;    // ...and ESC out of it again
+}
+
+double HeadlessRunner::Report::ticksPerSecond() const {
+    return seconds > 0.0 ? ticks / seconds : 0.0;
+}
+
+HeadlessRunner::HeadlessRunner(float simulationRate, std::uint32_t seed)
+    : sim(playerTexture, guardTexture, seed),
+      simulationStep(1.0f / simulationRate)
+{
+    sim.setLogging(false);
+}
+
+Simulation& HeadlessRunner::getSimulation() { return sim; }
+float HeadlessRunner::getSimulationStep() const { return simulationStep; }
+
+void HeadlessRunner::pressKey(TickInput& input, sf::Keyboard::Key key) {
+    InputEvent event;
+    event.type = InputEvent::Type::KEY_PRESSED;
+    event.code = static_cast<std::int32_t>(key);
+    input.events.push_back(event);
+}
+
+TickInput HeadlessRunner::scriptedInput(unsigned long long tick) const {
+    TickInput input;
+    input.held = LEGS[(tick / LEG_TICKS) % LEG_COUNT];
+
+    switch (sim.getState()) {
+        case GameState::MENU:
+            pressKey(input, sf::Keyboard::Key::Enter);
+            break;
+        case GameState::PLAYING:
+            if (tick % PUZZLE_EVERY == 0) pressKey(input, sf::Keyboard::Key::P);
+            else if (tick % INTERACT_EVERY == 0) pressKey(input, sf::Keyboard::Key::E);
+            break;
+        case GameState::PUZZLE_ACTIVE:
+            if (tick % PUZZLE_EVERY == PUZZLE_TICKS) pressKey(input, sf::Keyboard::Key::Escape);
+            break;
+        case GameState::PAUSED:
+            pressKey(input, sf::Keyboard::Key::Space);
+            break;
+        default:
+            break;
+    }
+    return input;
+}
+
+void HeadlessRunner::advance(const TickInput& input, bool autoRestart, Report& report) {
+    sim.step(simulationStep, input);
+    report.ticks++;
+
+    if (!autoRestart) return;
+    GameState state = sim.getState();
+    if (state == GameState::VICTORY || state == GameState::GAME_OVER) {
+        if (state == GameState::VICTORY) report.victories++;
+        else report.gameOvers++;
+        sim.restart();
+        report.sessions++;
+    }
+}
+
+HeadlessRunner::Report HeadlessRunner::run(unsigned long long ticks, InputRecorder* recorder) {
+    Report report;
+    report.sessions = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long tick = 0; tick < ticks; tick++) {
+        TickInput input = scriptedInput(tick);
+        if (recorder) recorder->record(input);
+        advance(input, true, report);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    report.seconds = std::chrono::duration<double>(end - start).count();
+    report.checksum = sim.checksum();
+    if (recorder) recorder->close(report.checksum);
+    return report;
+}
+
+HeadlessRunner::Report HeadlessRunner::replay(InputReplay& log) {
+    const InputLogHeader& header = log.getHeader();
+    simulationStep = header.simulationStep;
+    sim.restart(header.seed);
+    bool autoRestart = (header.flags & LOG_AUTO_RESTART) != 0;
+
+    Report report;
+    report.sessions = 1;
+
+    TickInput input;
+    auto start = std::chrono::steady_clock::now();
+    while (log.next(input)) advance(input, autoRestart, report);
+    auto end = std::chrono::steady_clock::now();
+
+    report.seconds = std::chrono::duration<double>(end - start).count();
+    report.checksum = sim.checksum();
+    if (!autoRestart) {
+        GameState state = sim.getState();
+        if (state == GameState::VICTORY) report.victories++;
+        else if (state == GameState::GAME_OVER) report.gameOvers++;
+    }
+    return report;
+}
@@ -0,0 +1,56 @@
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include "Simulation.h"
+#include "InputLog.h"
+
+// HeadlessRunner - Steps a Simulation as fast as the CPU allows with no
+// window, fonts or images. Input comes from a fixed script or from a
+// recorded input log; scripted runs restart finished sessions so any
+// number of ticks can be run back to back.
+class HeadlessRunner {
+public:
+    struct Report {
+        unsigned long long ticks = 0;
+        double seconds = 0.0; // Wall-clock time spent stepping
+        unsigned int sessions = 0; // Sessions started (including the last, unfinished one)
+        unsigned int victories = 0;
+        unsigned int gameOvers = 0;
+        std::uint64_t checksum = 0; // Simulation state after the last tick
+
+        double ticksPerSecond() const;
+    };
+
+private:
+    // Never loaded: entities only need something to reference
+    sf::Texture playerTexture;
+    sf::Texture guardTexture;
+
+    Simulation sim;
+    float simulationStep;
+
+    // Scripted input for a tick; the same tick always gets the same input
+    TickInput scriptedInput(unsigned long long tick) const;
+    static void pressKey(TickInput& input, sf::Keyboard::Key key);
+
+    // Step once; restart the session afterwards if it ended and autoRestart is set
+    void advance(const TickInput& input, bool autoRestart, Report& report);
+
+public:
+    // Constructor
+    HeadlessRunner(float simulationRate = 120.0f, std::uint32_t seed = Simulation::DEFAULT_SEED);
+
+    // Scripted run, optionally recorded to an input log
+    Report run(unsigned long long ticks, InputRecorder* recorder = nullptr);
+
+    // Replay a recorded log through the same step path
+    Report replay(InputReplay& log);
+
+    Simulation& getSimulation();
+    float getSimulationStep() const;
+};
+
+#endif // HEADLESS_RUNNER_H
@@ -0,0 +1,86 @@
+/*
+ * Museum Escape - Hud Class Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Hud.h"
+#include "AllocationCounter.h"
+#include <cstdio>
+
+// Constructor - same layout the per-frame version used to build
+Hud::Hud(const sf::Font& font)
+    : topBar({800.0f, 40.0f}),
+      roomLabel(font, 18, sf::Color::Cyan),
+      timeLabel(font, 18, sf::Color::White),
+      hintLabel(font, 14, sf::Color(150, 150, 150)),
+      statsLabel(font, 14, sf::Color::Green),
+      frameLabel(font, 14, sf::Color::Green),
+      showStats(false)
+{
+    topBar.setFillColor(sf::Color(30, 30, 30));
+    topBar.setOutlineThickness(1.0f);
+    topBar.setOutlineColor(sf::Color(100, 100, 100));
+
+    roomLabel.setPosition({10.0f, 8.0f});
+    timeLabel.setPosition({790.0f, 8.0f}, TextAlign::RIGHT);
+    hintLabel.setPosition({550.0f, 580.0f});
+    hintLabel.setString("[I] Inventory  [P] Puzzle  [ESC] Pause");
+    statsLabel.setPosition({10.0f, 580.0f});
+    frameLabel.setPosition({10.0f, 562.0f});
+}
+
+void Hud::setFont(const sf::Font& font) {
+    roomLabel.setFont(font);
+    timeLabel.setFont(font);
+    hintLabel.setFont(font);
+    statsLabel.setFont(font);
+    frameLabel.setFont(font);
+}
+
+void Hud::setRoomName(const std::string& name) {
+    roomLabel.setString("LOCATION: " + name);
+}
+
+void Hud::setTime(const std::string& formattedTime, bool critical) {
+    // Compare before concatenating: the formatted time only changes once a second
+    const std::string& shown = timeLabel.getString();
+    static const std::string prefix = "TIME REMAINING: ";
+    if (shown.size() != prefix.size() + formattedTime.size() ||
+        shown.compare(prefix.size(), std::string::npos, formattedTime) != 0) {
+        timeLabel.setString(prefix + formattedTime);
+    }
+    timeLabel.setFillColor(critical ? sf::Color::Red : sf::Color::White);
+}
+
+void Hud::setLayoutStats(unsigned int layoutsLastFrame, unsigned long long allocationsLastFrame) {
+    if (!showStats) return;
+    char text[96];
+    if (AllocationCounter::isEnabled()) {
+        // SFML's DLLs allocate through their own runtime (see AllocationCounter.h)
+        const char* scope = AllocationCounter::countsLibraries() ? "" : " (game only)";
+        std::snprintf(text, sizeof(text), "Text layouts: %u  Heap allocations%s: %llu", layoutsLastFrame, scope, allocationsLastFrame);
+    } else {
+        std::snprintf(text, sizeof(text), "Text layouts: %u", layoutsLastFrame);
+    }
+    statsLabel.setString(text);
+}
+
+void Hud::setFrameStats(float p50, float p99, float max) {
+    char text[96];
+    std::snprintf(text, sizeof(text), "Frame ms  p50 %.2f  p99 %.2f  max %.2f", p50, p99, max);
+    frameLabel.setString(text);
+}
+
+void Hud::toggleStats() { showStats = !showStats; }
+bool Hud::isShowingStats() const { return showStats; }
+
+void Hud::draw(sf::RenderWindow& window) {
+    window.draw(topBar);
+    window.draw(roomLabel);
+    window.draw(timeLabel);
+    window.draw(hintLabel);
+    if (showStats) {
+        window.draw(statsLabel);
+        if (!frameLabel.getString().empty()) window.draw(frameLabel);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include "Label.h"
+
+// Hud - Retained in-game heads-up display (top bar, location, timer, key
+// hints). Widgets are built once; the game only pushes bound values, and a
+// label is laid out again only when its value changes.
+class Hud {
+private:
+    sf::RectangleShape topBar;
+    Label roomLabel;
+    Label timeLabel;
+    Label hintLabel;
+    Label statsLabel; // Debug: text re-layouts in the previous frame
+    Label frameLabel; // Debug: frame-time percentiles (profiling builds)
+    bool showStats;
+
+public:
+    // Constructor
+    Hud(const sf::Font& font);
+
+    void setFont(const sf::Font& font);
+
+    // Bound values
+    void setRoomName(const std::string& name);
+    void setTime(const std::string& formattedTime, bool critical);
+    // Allocations are shown only where they are counted (profiling builds)
+    void setLayoutStats(unsigned int layoutsLastFrame, unsigned long long allocationsLastFrame);
+    void setFrameStats(float p50, float p99, float max); // Milliseconds
+
+    void toggleStats();
+    bool isShowingStats() const;
+
+    // Rendering
+    void draw(sf::RenderWindow& window);
+};
+
+#endif // HUD_H
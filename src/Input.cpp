@@ -0,0 +1,65 @@
+/*
+ * Museum Escape - Input Conversion Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Input.h"
+
+namespace {
+    const std::uint8_t MOD_ALT = 1 << 0;
+    const std::uint8_t MOD_CONTROL = 1 << 1;
+    const std::uint8_t MOD_SHIFT = 1 << 2;
+    const std::uint8_t MOD_SYSTEM = 1 << 3;
+}
+
+std::optional<InputEvent> InputEvent::fromEvent(const sf::Event& event) {
+    InputEvent result;
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        result.type = Type::KEY_PRESSED;
+        result.code = static_cast<std::int32_t>(keyPressed->code);
+        if (keyPressed->alt) result.modifiers |= MOD_ALT;
+        if (keyPressed->control) result.modifiers |= MOD_CONTROL;
+        if (keyPressed->shift) result.modifiers |= MOD_SHIFT;
+        if (keyPressed->system) result.modifiers |= MOD_SYSTEM;
+        return result;
+    }
+    if (const auto* textEntered = event.getIf<sf::Event::TextEntered>()) {
+        result.type = Type::TEXT_ENTERED;
+        result.code = static_cast<std::int32_t>(textEntered->unicode);
+        return result;
+    }
+    if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
+        result.type = Type::MOUSE_PRESSED;
+        result.code = static_cast<std::int32_t>(mousePressed->button);
+        result.x = mousePressed->position.x;
+        result.y = mousePressed->position.y;
+        return result;
+    }
+    return std::nullopt;
+}
+
+sf::Event InputEvent::toEvent() const {
+    switch (type) {
+        case Type::TEXT_ENTERED: {
+            sf::Event::TextEntered textEntered;
+            textEntered.unicode = static_cast<char32_t>(code);
+            return textEntered;
+        }
+        case Type::MOUSE_PRESSED: {
+            sf::Event::MouseButtonPressed mousePressed;
+            mousePressed.button = static_cast<sf::Mouse::Button>(code);
+            mousePressed.position = {x, y};
+            return mousePressed;
+        }
+        case Type::KEY_PRESSED:
+        default: {
+            sf::Event::KeyPressed keyPressed;
+            keyPressed.code = static_cast<sf::Keyboard::Key>(code);
+            keyPressed.alt = (modifiers & MOD_ALT) != 0;
+            keyPressed.control = (modifiers & MOD_CONTROL) != 0;
+            keyPressed.shift = (modifiers & MOD_SHIFT) != 0;
+            keyPressed.system = (modifiers & MOD_SYSTEM) != 0;
+            return keyPressed;
+        }
+    }
+}
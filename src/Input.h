@@ -0,0 +1,43 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <SFML/Window/Event.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Movement keys held during a tick
+struct PlayerInput {
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+};
+
+// InputEvent - The part of an sf::Event the simulation reacts to, in a
+// form that can be stored and replayed exactly
+struct InputEvent {
+    enum class Type : std::uint8_t {
+        KEY_PRESSED,
+        TEXT_ENTERED,
+        MOUSE_PRESSED
+    };
+
+    Type type = Type::KEY_PRESSED;
+    std::int32_t code = 0;      // Key code, unicode character or mouse button
+    std::uint8_t modifiers = 0; // KEY_PRESSED: alt/control/shift/system bits
+    std::int32_t x = 0;         // MOUSE_PRESSED: window position
+    std::int32_t y = 0;
+
+    // Events the simulation ignores (resize, focus, mouse move...) give nothing
+    static std::optional<InputEvent> fromEvent(const sf::Event& event);
+    sf::Event toEvent() const;
+};
+
+// TickInput - Everything that goes into one fixed simulation tick
+struct TickInput {
+    PlayerInput held;
+    std::vector<InputEvent> events;
+};
+
+#endif // INPUT_H
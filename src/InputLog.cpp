@@ -0,0 +1,281 @@
+/*
+ * Museum Escape - Input Log Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "InputLog.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char MAGIC[4] = {'M', 'E', 'L', 'G'};
+    const std::size_t HEADER_SIZE = 32;
+    const std::streamoff TICK_COUNT_OFFSET = 16;
+
+    const std::uint8_t RECORD_KEYS_MASK = 0x0F;
+    const std::uint8_t RECORD_HAS_EVENTS = 0x10;
+
+    // Flush encoded records to disk once this much has accumulated
+    const std::size_t FLUSH_THRESHOLD = 4096;
+
+    std::uint8_t packKeys(const PlayerInput& held) {
+        return (held.up ? 1 : 0) | (held.down ? 2 : 0) | (held.left ? 4 : 0) | (held.right ? 8 : 0);
+    }
+
+    PlayerInput unpackKeys(std::uint8_t bits) {
+        PlayerInput held;
+        held.up = (bits & 1) != 0;
+        held.down = (bits & 2) != 0;
+        held.left = (bits & 4) != 0;
+        held.right = (bits & 8) != 0;
+        return held;
+    }
+
+    void putFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+
+    std::uint64_t getFixed(const std::uint8_t* in, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    bool getVarint(const std::vector<std::uint8_t>& in, std::size_t& pos, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+            std::uint8_t byte = in[pos++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    void putSigned(std::vector<std::uint8_t>& out, std::int32_t value) {
+        putVarint(out, (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31));
+    }
+
+    bool getSigned(const std::vector<std::uint8_t>& in, std::size_t& pos, std::int32_t& value) {
+        std::uint64_t raw;
+        if (!getVarint(in, pos, raw)) return false;
+        std::uint32_t bits = static_cast<std::uint32_t>(raw);
+        value = static_cast<std::int32_t>((bits >> 1) ^ (~(bits & 1) + 1));
+        return true;
+    }
+
+    std::uint32_t floatBits(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float bitsToFloat(std::uint32_t bits) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void encodeHeader(std::vector<std::uint8_t>& out, const InputLogHeader& header) {
+        out.insert(out.end(), MAGIC, MAGIC + 4);
+        putFixed(out, header.version, 2);
+        putFixed(out, header.flags, 2);
+        putFixed(out, floatBits(header.simulationStep), 4);
+        putFixed(out, header.seed, 4);
+        putFixed(out, header.tickCount, 8);
+        putFixed(out, header.checksum, 8);
+    }
+}
+
+// ============================================================================
+// InputRecorder
+// ============================================================================
+
+InputRecorder::InputRecorder()
+    : runKeys(0),
+      runLength(0) {}
+
+InputRecorder::~InputRecorder() {
+    // Without a checksum the replay still works, it just cannot verify itself
+    if (file.is_open()) close(0);
+}
+
+bool InputRecorder::open(const std::string& path, float simulationStep, std::uint32_t seed, std::uint16_t flags) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: Could not open input log " << path << " for writing." << std::endl;
+        return false;
+    }
+
+    header = InputLogHeader();
+    header.flags = flags;
+    header.simulationStep = simulationStep;
+    header.seed = seed;
+    runLength = 0;
+
+    buffer.clear();
+    encodeHeader(buffer, header);
+    flushBuffer();
+    return true;
+}
+
+bool InputRecorder::isOpen() const { return file.is_open(); }
+std::uint64_t InputRecorder::getTickCount() const { return header.tickCount; }
+
+void InputRecorder::record(const TickInput& input) {
+    if (!file.is_open()) return;
+    header.tickCount++;
+
+    std::uint8_t keys = packKeys(input.held);
+    if (input.events.empty()) {
+        // Idle ticks with unchanged keys collapse into one record
+        if (runLength > 0 && keys != runKeys) flushRun();
+        runKeys = keys;
+        runLength++;
+        return;
+    }
+
+    flushRun();
+    buffer.push_back(keys | RECORD_HAS_EVENTS);
+    putVarint(buffer, input.events.size());
+    for (const InputEvent& event : input.events) {
+        buffer.push_back(static_cast<std::uint8_t>(event.type));
+        putSigned(buffer, event.code);
+        switch (event.type) {
+            case InputEvent::Type::KEY_PRESSED:
+                buffer.push_back(event.modifiers);
+                break;
+            case InputEvent::Type::MOUSE_PRESSED:
+                putSigned(buffer, event.x);
+                putSigned(buffer, event.y);
+                break;
+            default:
+                break;
+        }
+    }
+    if (buffer.size() >= FLUSH_THRESHOLD) flushBuffer();
+}
+
+void InputRecorder::flushRun() {
+    if (runLength == 0) return;
+    buffer.push_back(runKeys);
+    putVarint(buffer, runLength);
+    runLength = 0;
+}
+
+void InputRecorder::flushBuffer() {
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+void InputRecorder::close(std::uint64_t finalChecksum) {
+    if (!file.is_open()) return;
+    flushRun();
+    flushBuffer();
+
+    header.checksum = finalChecksum;
+    std::vector<std::uint8_t> trailer;
+    putFixed(trailer, header.tickCount, 8);
+    putFixed(trailer, header.checksum, 8);
+    file.seekp(TICK_COUNT_OFFSET);
+    file.write(reinterpret_cast<const char*>(trailer.data()), static_cast<std::streamsize>(trailer.size()));
+    file.close();
+}
+
+// ============================================================================
+// InputReplay
+// ============================================================================
+
+InputReplay::InputReplay()
+    : cursor(0),
+      runKeys(0),
+      runRemaining(0),
+      ticksRead(0) {}
+
+bool InputReplay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Could not open input log " << path << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, 4) != 0) {
+        std::cerr << "Error: " << path << " is not an input log." << std::endl;
+        data.clear();
+        return false;
+    }
+
+    const std::uint8_t* in = data.data() + 4;
+    header.version = static_cast<std::uint16_t>(getFixed(in, 2));
+    header.flags = static_cast<std::uint16_t>(getFixed(in + 2, 2));
+    header.simulationStep = bitsToFloat(static_cast<std::uint32_t>(getFixed(in + 4, 4)));
+    header.seed = static_cast<std::uint32_t>(getFixed(in + 8, 4));
+    header.tickCount = getFixed(in + 12, 8);
+    header.checksum = getFixed(in + 20, 8);
+    if (header.version != 1) {
+        std::cerr << "Error: Unsupported input log version " << header.version << std::endl;
+        data.clear();
+        return false;
+    }
+
+    cursor = HEADER_SIZE;
+    runRemaining = 0;
+    ticksRead = 0;
+    return true;
+}
+
+bool InputReplay::next(TickInput& input) {
+    input.events.clear();
+
+    if (runRemaining == 0) {
+        if (isFinished()) return false;
+
+        std::uint8_t record = data[cursor++];
+        if (record & RECORD_HAS_EVENTS) {
+            input.held = unpackKeys(record & RECORD_KEYS_MASK);
+            std::uint64_t count;
+            if (!getVarint(data, cursor, count)) return false;
+            for (std::uint64_t i = 0; i < count; i++) {
+                if (cursor >= data.size()) return false;
+                InputEvent event;
+                event.type = static_cast<InputEvent::Type>(data[cursor++]);
+                if (!getSigned(data, cursor, event.code)) return false;
+                if (event.type == InputEvent::Type::KEY_PRESSED) {
+                    if (cursor >= data.size()) return false;
+                    event.modifiers = data[cursor++];
+                } else if (event.type == InputEvent::Type::MOUSE_PRESSED) {
+                    if (!getSigned(data, cursor, event.x) || !getSigned(data, cursor, event.y)) return false;
+                }
+                input.events.push_back(event);
+            }
+            ticksRead++;
+            return true;
+        }
+
+        runKeys = record & RECORD_KEYS_MASK;
+        if (!getVarint(data, cursor, runRemaining) || runRemaining == 0) return false;
+    }
+
+    input.held = unpackKeys(runKeys);
+    runRemaining--;
+    ticksRead++;
+    return true;
+}
+
+// A log whose recorder never closed has no tick count; read it to the end
+bool InputReplay::isFinished() const {
+    if (header.tickCount > 0 && ticksRead >= header.tickCount) return true;
+    return runRemaining == 0 && cursor >= data.size();
+}
+
+const InputLogHeader& InputReplay::getHeader() const { return header; }
+std::uint64_t InputReplay::getTicksRead() const { return ticksRead; }
@@ -0,0 +1,90 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Input.h"
+
+// Binary input log: a 32-byte header followed by one record per run of
+// ticks. All integers are little-endian; counts and event fields are
+// LEB128 varints (signed ones zigzag-encoded).
+//
+//   header:  "MELG" u16 version, u16 flags, u32 step (float bits),
+//            u32 seed, u64 tickCount, u64 checksum (state after last tick)
+//   record:  u8 held keys (bits 0-3) | RECORD_HAS_EVENTS
+//            with events:  varint count, then per event u8 type + fields;
+//                          covers exactly one tick
+//            without:      varint run length of identical idle ticks
+struct InputLogHeader {
+    std::uint16_t version = 1;
+    std::uint16_t flags = 0;
+    float simulationStep = 1.0f / 120.0f;
+    std::uint32_t seed = 0;
+    std::uint64_t tickCount = 0;
+    std::uint64_t checksum = 0;
+};
+
+// Header flags
+const std::uint16_t LOG_AUTO_RESTART = 1 << 0; // Finished sessions were restarted (headless runs)
+
+// InputRecorder - Appends tick inputs to a log file
+class InputRecorder {
+private:
+    std::ofstream file;
+    InputLogHeader header;
+
+    // Pending run of idle ticks with the same held keys
+    std::uint8_t runKeys;
+    std::uint64_t runLength;
+
+    std::vector<std::uint8_t> buffer; // Encoded records not yet written
+
+    void flushRun();
+    void flushBuffer();
+
+public:
+    // Constructor
+    InputRecorder();
+    ~InputRecorder();
+
+    bool open(const std::string& path, float simulationStep, std::uint32_t seed, std::uint16_t flags = 0);
+    bool isOpen() const;
+
+    void record(const TickInput& input);
+
+    // Write the remaining records and patch tick count and checksum into the header
+    void close(std::uint64_t finalChecksum);
+
+    std::uint64_t getTickCount() const;
+};
+
+// InputReplay - Reads a whole log into memory and hands it back tick by tick
+class InputReplay {
+private:
+    InputLogHeader header;
+    std::vector<std::uint8_t> data;
+    std::size_t cursor;
+
+    // Current run of idle ticks
+    std::uint8_t runKeys;
+    std::uint64_t runRemaining;
+
+    std::uint64_t ticksRead;
+
+public:
+    // Constructor
+    InputReplay();
+
+    bool load(const std::string& path);
+
+    // Fill in the next tick; false once the log is exhausted
+    bool next(TickInput& input);
+    bool isFinished() const;
+
+    const InputLogHeader& getHeader() const;
+    std::uint64_t getTicksRead() const;
+};
+
+#endif // INPUT_LOG_H
@@ -5,21 +5,26 @@
  */
 
 #include "Item.h"
+#include "FrameArena.h"
+#include "SpriteBatch.h"
+#include "EventBus.h"
 
 Item::Item(const std::string& itemName, const std::string& desc, float x, float y)
-    : name(itemName), description(desc), position(x, y), isCollected(false) {
+    : name(itemName), id(ItemRegistry::global().intern(itemName)), description(desc), position(x, y), isCollected(false) {
     sprite.setSize({20.0f, 20.0f});
     sprite.setPosition(position);
     sprite.setFillColor(sf::Color::Yellow);
 }
 
-std::string Item::getName() const { return name; }
-std::string Item::getDescription() const { return description; }
+const std::string& Item::getName() const { return name; }
+ItemId Item::getId() const { return id; }
+const std::string& Item::getDescription() const { return description; }
 sf::Vector2f Item::getPosition() const { return position; }
 bool Item::isItemCollected() const { return isCollected; }
 sf::FloatRect Item::getBounds() const { return sprite.getGlobalBounds(); }
 void Item::collect() { isCollected = true; }
-void Item::draw(sf::RenderWindow& window) { if (!isCollected) window.draw(sprite); }
+void Item::draw(sf::RenderTarget& target) { if (!isCollected) target.draw(sprite); }
+void Item::draw(SpriteBatch& batch) { if (!isCollected) batch.add(sprite); }
 bool Item::checkCollision(const sf::FloatRect& bounds) {
     return sprite.getGlobalBounds().findIntersection(bounds).has_value();
 }
@@ -45,119 +50,144 @@ BasicItem::BasicItem(const std::string& itemName, const std::string& desc, float
 void BasicItem::use() {}
 
 Inventory::Inventory(int capacity)
-    : maxCapacity(capacity), isVisible(false), background({400.0f, 500.0f}) {
+    : events(nullptr), maxCapacity(capacity), isVisible(false), background({400.0f, 500.0f}) {
     background.setFillColor(sf::Color(0, 0, 0, 200));
     background.setOutlineThickness(3.0f);
     background.setOutlineColor(sf::Color::White);
     background.setPosition({200.0f, 50.0f}); // Fixed
+    
+    dimmer.setSize({800.0f, 600.0f});
+    dimmer.setFillColor(sf::Color(0, 0, 0, 100));
+    card.setSize({400.0f, 500.0f});
+    card.setPosition({200.0f, 50.0f}); // FIXED
+    card.setFillColor(sf::Color(40, 44, 52));
+    card.setOutlineThickness(2.0f);
+    card.setOutlineColor(sf::Color::Cyan);
+    header.setSize({400.0f, 60.0f});
+    header.setPosition({200.0f, 50.0f}); // FIXED
+    header.setFillColor(sf::Color(25, 28, 33));
+    strip.setSize({380.0f, 50.0f});
+    strip.setFillColor(sf::Color(255, 255, 255, 10));
 }
 
+void Inventory::setEventBus(EventBus* bus) { events = bus; }
+
 bool Inventory::addItem(std::shared_ptr<Item> item) {
     if (items.size() < static_cast<size_t>(maxCapacity)) {
+        held.insert(item->getId());
         items.push_back(item);
+        if (events) events->publish(GameEvent::Type::ITEM_COLLECTED, item->getId());
         return true;
     }
     return false;
 }
 
-bool Inventory::removeItem(const std::string& itemName) {
+bool Inventory::removeItem(ItemId id) {
+    if (!held.contains(id)) return false;
     for (auto it = items.begin(); it != items.end(); ++it) {
-        if ((*it)->getName() == itemName) {
+        if ((*it)->getId() == id) {
             items.erase(it);
-            return true;
+            break;
         }
     }
-    return false;
+    // Another copy of the same item may still be held
+    held.erase(id);
+    for (const auto& item : items) if (item->getId() == id) held.insert(id);
+    if (events) events->publish(GameEvent::Type::ITEM_REMOVED, id);
+    return true;
 }
 
+bool Inventory::removeItem(const std::string& itemName) {
+    return removeItem(ItemRegistry::global().find(itemName));
+}
+
+bool Inventory::hasItem(ItemId id) const { return id != NO_ITEM && held.contains(id); }
+
 bool Inventory::hasItem(const std::string& itemName) const {
-    for (const auto& item : items) if (item->getName() == itemName) return true;
-    return false;
+    return hasItem(ItemRegistry::global().find(itemName));
 }
 
-std::shared_ptr<Item> Inventory::getItem(const std::string& itemName) {
-    for (auto& item : items) if (item->getName() == itemName) return item;
+std::shared_ptr<Item> Inventory::getItem(ItemId id) {
+    if (!hasItem(id)) return nullptr;
+    for (auto& item : items) if (item->getId() == id) return item;
     return nullptr;
 }
 
+std::shared_ptr<Item> Inventory::getItem(const std::string& itemName) {
+    return getItem(ItemRegistry::global().find(itemName));
+}
+
 int Inventory::getItemCount() const { return items.size(); }
 int Inventory::getMaxCapacity() const { return maxCapacity; }
 bool Inventory::isFull() const { return items.size() >= static_cast<size_t>(maxCapacity); }
-std::vector<std::shared_ptr<Item>>& Inventory::getItems() { return items; }
+const std::vector<std::shared_ptr<Item>>& Inventory::getItems() const { return items; }
 void Inventory::toggleVisibility() { isVisible = !isVisible; }
 void Inventory::setVisible(bool visible) { isVisible = visible; }
 bool Inventory::getVisible() const { return isVisible; }
-void Inventory::setFont(const sf::Font& f) { font = f; }
-
-void Inventory::draw(sf::RenderWindow& window) {
-    if (!isVisible) return;
+void Inventory::setFont(FontHandle f) {
+    font = f;
+    if (!font) return;
+    if (titleLabel) {
+        titleLabel->setFont(*font);
+        capacityLabel->setFont(*font);
+        emptyLabel->setFont(*font);
+        for (Label& label : nameLabels) label.setFont(*font);
+        for (Label& label : descriptionLabels) label.setFont(*font);
+        return;
+    }
     
-    sf::RectangleShape dimmer({800.0f, 600.0f});
-    dimmer.setFillColor(sf::Color(0, 0, 0, 100));
-    window.draw(dimmer);
-
-    sf::RectangleShape card({400.0f, 500.0f});
-    card.setPosition({200.0f, 50.0f}); // FIXED
-    card.setFillColor(sf::Color(40, 44, 52));
-    card.setOutlineThickness(2.0f);
-    card.setOutlineColor(sf::Color::Cyan);
-    window.draw(card);
+    titleLabel = std::make_unique<Label>(*font, 28, sf::Color::White);
+    titleLabel->setStyle(sf::Text::Bold);
+    titleLabel->setString("BACKPACK");
+    titleLabel->setPosition({220.0f, 62.0f}); // FIXED
+    
+    capacityLabel = std::make_unique<Label>(*font, 20, sf::Color::Cyan);
+    capacityLabel->setPosition({540.0f, 68.0f}); // FIXED
+    
+    emptyLabel = std::make_unique<Label>(*font, 18, sf::Color(150, 150, 150));
+    emptyLabel->setString("Your backpack is empty.");
+    emptyLabel->setPosition({400.0f, 250.0f}, TextAlign::CENTER); // FIXED
+}
 
-    sf::RectangleShape header({400.0f, 60.0f});
-    header.setPosition({200.0f, 50.0f}); // FIXED
-    header.setFillColor(sf::Color(25, 28, 33));
-    window.draw(header);
-
-    sf::Text title(font);
-    title.setString("BACKPACK");
-    title.setCharacterSize(28);
-    title.setStyle(sf::Text::Bold);
-    title.setFillColor(sf::Color::White);
-    title.setPosition({220.0f, 62.0f}); // FIXED
-    window.draw(title);
+void Inventory::draw(sf::RenderTarget& target, FrameArena& arena) {
+    if (!isVisible || !titleLabel) return;
     
-    sf::Text capacity(font);
-    capacity.setString(std::to_string(items.size()) + "/" + std::to_string(maxCapacity));
-    capacity.setCharacterSize(20);
-    capacity.setFillColor(sf::Color::Cyan);
-    capacity.setPosition({540.0f, 68.0f}); // FIXED
-    window.draw(capacity);
+    target.draw(dimmer);
+    target.draw(card);
+    target.draw(header);
+    target.draw(*titleLabel);
+    
+    capacityLabel->setString(arena.format("%zu/%d", items.size(), maxCapacity));
+    target.draw(*capacityLabel);
 
-    float yOffset = 130.0f;
     if (items.empty()) {
-        sf::Text emptyText(font);
-        emptyText.setString("Your backpack is empty.");
-        emptyText.setCharacterSize(18);
-        emptyText.setFillColor(sf::Color(150, 150, 150));
-        sf::FloatRect bounds = emptyText.getLocalBounds();
-        emptyText.setPosition({400.0f - bounds.size.y/2.0f, 250.0f}); // FIXED
-        window.draw(emptyText);
-    } else {
-        for (size_t i = 0; i < items.size(); ++i) {
-            if (i % 2 == 0) {
-                sf::RectangleShape strip({380.0f, 50.0f});
-                strip.setPosition({210.0f, yOffset - 10.0f}); // FIXED
-                strip.setFillColor(sf::Color(255, 255, 255, 10));
-                window.draw(strip);
-            }
-            sf::Text itemText(font);
-            itemText.setString(items[i]->getName());
-            itemText.setCharacterSize(22);
-            itemText.setFillColor(sf::Color::Yellow);
-            itemText.setPosition({230.0f, yOffset}); // FIXED
-            window.draw(itemText);
-            
-            sf::Text descText(font);
-            descText.setString(items[i]->getDescription());
-            descText.setCharacterSize(14);
-            descText.setStyle(sf::Text::Italic);
-            descText.setFillColor(sf::Color(200, 200, 200));
-            descText.setPosition({230.0f, yOffset + 26.0f}); // FIXED
-            window.draw(descText);
-            
-            yOffset += 60.0f;
+        target.draw(*emptyLabel);
+        return;
+    }
+    
+    float yOffset = 130.0f;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i % 2 == 0) {
+            strip.setPosition({210.0f, yOffset - 10.0f}); // FIXED
+            target.draw(strip);
+        }
+        if (i == nameLabels.size()) {
+            nameLabels.emplace_back(*font, 22, sf::Color::Yellow);
+            nameLabels.back().setPosition({230.0f, yOffset}); // FIXED
+            descriptionLabels.emplace_back(*font, 14, sf::Color(200, 200, 200));
+            descriptionLabels.back().setStyle(sf::Text::Italic);
+            descriptionLabels.back().setPosition({230.0f, yOffset + 26.0f}); // FIXED
         }
+        nameLabels[i].setString(items[i]->getName());
+        descriptionLabels[i].setString(items[i]->getDescription());
+        target.draw(nameLabels[i]);
+        target.draw(descriptionLabels[i]);
+        
+        yOffset += 60.0f;
     }
 }
 
-void Inventory::clear() { items.clear(); }
\ No newline at end of file
+void Inventory::clear() {
+    items.clear();
+    held.clear();
+}
\ No newline at end of file
@@ -5,11 +5,21 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include "ResourceCache.h"
+#include "ItemRegistry.h"
+#include "Label.h"
+
+class SpriteBatch;
+class EventBus;
+class FrameArena;
 
 // Base Item class
-class Item {
+// Items are always owned by shared_ptr; shared_from_this lets broadphase
+// queries (which hand out raw pointers) pass an item on to the inventory
+class Item : public std::enable_shared_from_this<Item> {
 protected:
     std::string name;
+    ItemId id; // Interned name
     std::string description;
     sf::Vector2f position;
     sf::RectangleShape sprite;
@@ -21,8 +31,9 @@ public:
     virtual ~Item() = default;
     
     // Getters
-    std::string getName() const;
-    std::string getDescription() const;
+    const std::string& getName() const;
+    ItemId getId() const;
+    const std::string& getDescription() const;
     sf::Vector2f getPosition() const;
     bool isItemCollected() const;
     sf::FloatRect getBounds() const;
@@ -32,7 +43,8 @@ public:
     virtual void use() = 0; // Pure virtual - each item type has unique use
     
     // Rendering
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderTarget& target);
+    void draw(SpriteBatch& batch);
     
     // Collision
     bool checkCollision(const sf::FloatRect& bounds);
@@ -74,35 +86,54 @@ public:
 class Inventory {
 private:
     std::vector<std::shared_ptr<Item>> items;
+    ItemSet held; // Membership by ID, mirrors items
+    EventBus* events; // ITEM_COLLECTED / ITEM_REMOVED are published here
     int maxCapacity;
-    sf::Font font;
+    FontHandle font; // Shared from the ResourceCache
     sf::RectangleShape background;
     bool isVisible;
     
+    // Retained panel: labels are built when the font arrives and rows are
+    // added only as the contents grow, so an open backpack allocates nothing
+    sf::RectangleShape dimmer;
+    sf::RectangleShape card;
+    sf::RectangleShape header;
+    sf::RectangleShape strip;
+    std::unique_ptr<Label> titleLabel;
+    std::unique_ptr<Label> capacityLabel;
+    std::unique_ptr<Label> emptyLabel;
+    std::vector<Label> nameLabels;
+    std::vector<Label> descriptionLabels;
+    
 public:
     // Constructor
     Inventory(int capacity = 10);
     
+    void setEventBus(EventBus* bus);
+    
     // Item management
     bool addItem(std::shared_ptr<Item> item);
+    bool removeItem(ItemId id);
     bool removeItem(const std::string& itemName);
+    bool hasItem(ItemId id) const;
     bool hasItem(const std::string& itemName) const;
+    std::shared_ptr<Item> getItem(ItemId id);
     std::shared_ptr<Item> getItem(const std::string& itemName);
     
     // Inventory properties
     int getItemCount() const;
     int getMaxCapacity() const;
     bool isFull() const;
-    std::vector<std::shared_ptr<Item>>& getItems();
+    const std::vector<std::shared_ptr<Item>>& getItems() const;
     
     // Display
     void toggleVisibility();
     void setVisible(bool visible);
     bool getVisible() const;
-    void setFont(const sf::Font& f);
+    void setFont(FontHandle f);
     
-    // Rendering
-    void draw(sf::RenderWindow& window);
+    // Rendering (the capacity text is formatted in the frame's arena)
+    void draw(sf::RenderTarget& target, FrameArena& arena);
     
     // Clear inventory
     void clear();
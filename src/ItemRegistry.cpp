@@ -0,0 +1,69 @@
+/*
+ * Museum Escape - Item Registry Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "ItemRegistry.h"
+#include <algorithm>
+
+ItemRegistry::ItemRegistry() {
+    names.push_back("");
+    ids[""] = NO_ITEM;
+}
+
+ItemId ItemRegistry::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+
+    ItemId id = static_cast<ItemId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+ItemId ItemRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : NO_ITEM;
+}
+
+const std::string& ItemRegistry::nameOf(ItemId id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return id < names.size() ? names[id] : names[NO_ITEM];
+}
+
+std::size_t ItemRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.size();
+}
+
+ItemRegistry& ItemRegistry::global() {
+    static ItemRegistry registry;
+    return registry;
+}
+
+// ============================================================================
+// ItemSet
+// ============================================================================
+
+void ItemSet::insert(ItemId id) {
+    std::size_t word = id / 64;
+    if (word >= words.size()) words.resize(word + 1, 0);
+    words[word] |= std::uint64_t(1) << (id % 64);
+}
+
+void ItemSet::erase(ItemId id) {
+    std::size_t word = id / 64;
+    if (word < words.size()) words[word] &= ~(std::uint64_t(1) << (id % 64));
+}
+
+bool ItemSet::contains(ItemId id) const {
+    std::size_t word = id / 64;
+    return word < words.size() && (words[word] >> (id % 64)) & 1;
+}
+
+// Keeps the capacity: refilling never allocates
+void ItemSet::clear() {
+    std::fill(words.begin(), words.end(), 0);
+}
@@ -0,0 +1,51 @@
+#ifndef ITEM_REGISTRY_H
+#define ITEM_REGISTRY_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compact ID for an item or key name. Names are interned once, when items
+// and doors are created; gameplay checks compare IDs, never strings.
+using ItemId = std::uint32_t;
+const ItemId NO_ITEM = 0; // Empty name: "no key required"
+
+// ItemRegistry - Interns item/key names. Thread-safe, since rooms may be
+// built off the main thread; IDs are stable for the life of the process.
+class ItemRegistry {
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, ItemId> ids;
+    std::deque<std::string> names; // Indexed by ID; deque keeps references valid
+
+public:
+    // Constructor - registers the empty name as NO_ITEM
+    ItemRegistry();
+
+    ItemId intern(const std::string& name);
+    ItemId find(const std::string& name) const; // NO_ITEM if never interned
+    const std::string& nameOf(ItemId id) const;
+    std::size_t size() const;
+
+    // Registry shared by all items, doors and inventories
+    static ItemRegistry& global();
+};
+
+// ItemSet - Membership of item IDs as a bitset. contains() is a single
+// word test and never allocates; insert() grows the words only the first
+// time a higher ID is seen.
+class ItemSet {
+private:
+    std::vector<std::uint64_t> words;
+
+public:
+    void insert(ItemId id);
+    void erase(ItemId id);
+    bool contains(ItemId id) const;
+    void clear();
+};
+
+#endif // ITEM_REGISTRY_H
@@ -0,0 +1,86 @@
+/*
+ * Museum Escape - Label Class Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Label.h"
+#include "Profiler.h"
+
+unsigned int Label::layoutCount = 0;
+
+// Constructor
+Label::Label(const sf::Font& font, unsigned int characterSize, const sf::Color& color)
+    : text(font, "", characterSize),
+      align(TextAlign::LEFT)
+{
+    text.setFillColor(color);
+}
+
+// Rebuild glyph geometry now (getLocalBounds forces it) and re-anchor
+void Label::relayout() {
+    PROFILE_SCOPE("Label::relayout");
+    layoutCount++;
+    sf::FloatRect bounds = text.getLocalBounds();
+    sf::Vector2f position = anchor;
+    if (align == TextAlign::CENTER) position.x -= bounds.size.x / 2.0f;
+    else if (align == TextAlign::RIGHT) position.x -= bounds.size.x;
+    text.setPosition(position);
+}
+
+void Label::setString(std::string_view str) {
+    if (str == value) return;
+    value.assign(str.data(), str.size());
+    text.setString(value);
+    relayout();
+}
+
+const std::string& Label::getString() const { return value; }
+
+void Label::setFillColor(const sf::Color& color) {
+    if (text.getFillColor() != color) text.setFillColor(color);
+}
+
+void Label::setPosition(const sf::Vector2f& position, TextAlign alignment) {
+    anchor = position;
+    align = alignment;
+    sf::FloatRect bounds = text.getLocalBounds();
+    sf::Vector2f topLeft = anchor;
+    if (align == TextAlign::CENTER) topLeft.x -= bounds.size.x / 2.0f;
+    else if (align == TextAlign::RIGHT) topLeft.x -= bounds.size.x;
+    text.setPosition(topLeft);
+}
+
+void Label::setFont(const sf::Font& font) {
+    if (&text.getFont() == &font) return;
+    text.setFont(font);
+    relayout();
+}
+
+void Label::setCharacterSize(unsigned int size) {
+    if (text.getCharacterSize() == size) return;
+    text.setCharacterSize(size);
+    relayout();
+}
+
+void Label::setStyle(std::uint32_t style) {
+    if (text.getStyle() == style) return;
+    text.setStyle(style);
+    relayout();
+}
+
+void Label::setOutline(float thickness, const sf::Color& color) {
+    text.setOutlineColor(color);
+    if (text.getOutlineThickness() == thickness) return;
+    text.setOutlineThickness(thickness);
+    relayout();
+}
+
+sf::FloatRect Label::getGlobalBounds() const { return text.getGlobalBounds(); }
+
+unsigned int Label::getLayoutCount() { return layoutCount; }
+void Label::resetLayoutCount() { layoutCount = 0; }
+
+void Label::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (value.empty()) return;
+    target.draw(text, states);
+}
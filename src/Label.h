@@ -0,0 +1,55 @@
+#ifndef LABEL_H
+#define LABEL_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <string_view>
+
+enum class TextAlign {
+    LEFT,
+    CENTER,
+    RIGHT
+};
+
+// Label - Retained text widget. Keeps its sf::Text (and therefore its glyph
+// geometry) between frames and only re-lays it out when the bound string,
+// font or size actually changes. Every re-layout bumps a global counter so
+// the HUD can show how much text work a frame really did.
+class Label : public sf::Drawable {
+private:
+    sf::Text text;
+    std::string value;
+    sf::Vector2f anchor;
+    TextAlign align;
+
+    static unsigned int layoutCount;
+
+    void relayout();
+
+public:
+    // Constructor
+    Label(const sf::Font& font, unsigned int characterSize = 18, const sf::Color& color = sf::Color::White);
+
+    // Bound value - no work at all (not even a copy) if the string is unchanged
+    void setString(std::string_view str);
+    const std::string& getString() const;
+
+    // Appearance (color and position never touch the glyph geometry)
+    void setFillColor(const sf::Color& color);
+    void setPosition(const sf::Vector2f& position, TextAlign alignment = TextAlign::LEFT);
+    void setFont(const sf::Font& font);
+    void setCharacterSize(unsigned int size);
+    void setStyle(std::uint32_t style);
+    void setOutline(float thickness, const sf::Color& color);
+
+    sf::FloatRect getGlobalBounds() const;
+
+    // Re-layout instrumentation
+    static unsigned int getLayoutCount();
+    static void resetLayoutCount();
+
+    // Rendering
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+#endif // LABEL_H
@@ -0,0 +1,655 @@
+/*
+ * Museum Escape - Level Loader Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Level.h"
+#include "MappedFile.h"
+#include "Room.h"
+#include "Guard.h"
+#include "Item.h"
+#include "Puzzle.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+// The binary form is the in-memory records byte for byte
+static_assert(sizeof(LevelRoomRecord) == 72, "room record layout");
+static_assert(sizeof(LevelDoorRecord) == 20, "door record layout");
+static_assert(sizeof(LevelGuardRecord) == 20, "guard record layout");
+static_assert(sizeof(LevelPointRecord) == 8, "point record layout");
+static_assert(sizeof(LevelItemRecord) == 24, "item record layout");
+static_assert(sizeof(LevelPuzzleRecord) == 24, "puzzle record layout");
+static_assert(sizeof(LevelObstacleRecord) == 16, "obstacle record layout");
+
+namespace {
+    const char MAGIC[4] = {'M', 'E', 'L', 'V'};
+    const std::uint16_t VERSION = 2; // 2: obstacles
+    const std::size_t HEADER_SIZE = 48;
+    const std::size_t SECTION_COUNT = 9;
+
+    void putFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+
+    std::uint64_t getFixed(const std::uint8_t* in, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    template <typename T>
+    void appendSection(std::vector<std::uint8_t>& out, const std::vector<T>& records) {
+        const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(records.data());
+        out.insert(out.end(), bytes, bytes + records.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void copySection(const std::uint8_t*& cursor, std::uint32_t count, std::vector<T>& records) {
+        records.resize(count);
+        if (count > 0) std::memcpy(records.data(), cursor, count * sizeof(T));
+        cursor += count * sizeof(T);
+    }
+
+    // ========================================================================
+    // Text form
+    // ========================================================================
+
+    struct Token {
+        std::string text;
+        bool quoted;
+    };
+
+    bool tokenize(const std::string& line, std::vector<Token>& tokens, std::string& error) {
+        tokens.clear();
+        std::size_t i = 0;
+        while (i < line.size()) {
+            char c = line[i];
+            if (c == '#') break;
+            if (c == ' ' || c == '\t' || c == '\r') { i++; continue; }
+
+            Token token{"", c == '"'};
+            if (token.quoted) {
+                i++;
+                bool closed = false;
+                while (i < line.size()) {
+                    char q = line[i++];
+                    if (q == '"') { closed = true; break; }
+                    if (q == '\\' && i < line.size()) {
+                        char escaped = line[i++];
+                        token.text += escaped == 'n' ? '\n' : escaped;
+                    } else {
+                        token.text += q;
+                    }
+                }
+                if (!closed) {
+                    error = "unterminated string";
+                    return false;
+                }
+            } else {
+                while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && line[i] != '#') token.text += line[i++];
+            }
+            tokens.push_back(token);
+        }
+        return true;
+    }
+
+    bool toFloat(const Token& token, float& value) {
+        char* end = nullptr;
+        value = std::strtof(token.text.c_str(), &end);
+        return !token.quoted && !token.text.empty() && *end == '\0';
+    }
+
+    bool toInt(const Token& token, std::int32_t& value) {
+        char* end = nullptr;
+        long parsed = std::strtol(token.text.c_str(), &end, 10);
+        value = static_cast<std::int32_t>(parsed);
+        return !token.quoted && !token.text.empty() && *end == '\0';
+    }
+
+    // A room's contents as they are read; flattened once the file is done
+    struct StagedGuard {
+        LevelGuardRecord record;
+        std::vector<LevelPointRecord> points;
+    };
+
+    struct StagedPuzzle {
+        LevelPuzzleRecord record;
+        std::string label;
+        std::vector<std::int32_t> pattern;
+    };
+
+    struct StagedItem {
+        LevelItemRecord record;
+        std::string rewardLabel;
+    };
+
+    struct StagedRoom {
+        LevelRoomRecord record;
+        std::vector<LevelDoorRecord> doors;
+        std::vector<StagedGuard> guards;
+        std::vector<StagedPuzzle> puzzles;
+        std::vector<StagedItem> items;
+        std::vector<LevelObstacleRecord> obstacles;
+    };
+
+    class TextParser {
+    private:
+        LevelData& level;
+        std::vector<StagedRoom> rooms;
+        std::unordered_map<std::int32_t, std::size_t> roomIndex;
+        std::unordered_map<std::string, std::uint32_t> stringOffsets;
+        std::string& error;
+
+        bool fail(const std::string& message) {
+            error = message;
+            return false;
+        }
+
+        std::uint32_t addString(const std::string& text) {
+            if (text.empty()) return 0;
+            auto it = stringOffsets.find(text);
+            if (it != stringOffsets.end()) return it->second;
+            std::uint32_t offset = static_cast<std::uint32_t>(level.strings.size());
+            level.strings.insert(level.strings.end(), text.begin(), text.end());
+            level.strings.push_back('\0');
+            stringOffsets.emplace(text, offset);
+            return offset;
+        }
+
+        bool findRoom(const Token& token, StagedRoom*& room) {
+            std::int32_t id;
+            if (!toInt(token, id)) return fail("expected a room id, got '" + token.text + "'");
+            auto it = roomIndex.find(id);
+            if (it == roomIndex.end()) return fail("room " + token.text + " is used before it is declared");
+            room = &rooms[it->second];
+            return true;
+        }
+
+        bool parseFloats(const std::vector<Token>& tokens, std::size_t first, std::size_t count, float* out) {
+            if (tokens.size() < first + count) return fail("'" + tokens[0].text + "' has too few values");
+            for (std::size_t i = 0; i < count; i++) {
+                if (!toFloat(tokens[first + i], out[i])) return fail("expected a number, got '" + tokens[first + i].text + "'");
+            }
+            return true;
+        }
+
+        bool parseRoom(const std::vector<Token>& tokens) {
+            if (tokens.size() < 8) return fail("room needs: id name x y width height background");
+            StagedRoom room{};
+            float box[4];
+            if (!toInt(tokens[1], room.record.id)) return fail("expected a room id, got '" + tokens[1].text + "'");
+            if (!parseFloats(tokens, 3, 4, box)) return false;
+            if (roomIndex.count(room.record.id)) return fail("room " + tokens[1].text + " is declared twice");
+
+            room.record.name = addString(tokens[2].text);
+            room.record.x = box[0];
+            room.record.y = box[1];
+            room.record.width = box[2];
+            room.record.height = box[3];
+            room.record.background = addString(tokens[7].text);
+            for (std::size_t i = 8; i < tokens.size(); i++) {
+                if (tokens[i].text == "exit") room.record.flags |= LEVEL_ROOM_EXIT;
+                else return fail("unknown room option '" + tokens[i].text + "'");
+            }
+            roomIndex[room.record.id] = rooms.size();
+            rooms.push_back(std::move(room));
+            return true;
+        }
+
+        bool parseDoor(const std::vector<Token>& tokens) {
+            StagedRoom* room;
+            if (tokens.size() < 5) return fail("door needs: room x y targetRoom");
+            if (!findRoom(tokens[1], room)) return false;
+
+            LevelDoorRecord door{};
+            float position[2];
+            if (!parseFloats(tokens, 2, 2, position)) return false;
+            door.x = position[0];
+            door.y = position[1];
+            if (!toInt(tokens[4], door.targetRoom)) return fail("expected a target room, got '" + tokens[4].text + "'");
+            if (tokens.size() > 5) {
+                if (tokens[5].text != "locked" || tokens.size() != 7) return fail("door options are: locked <key>");
+                door.flags |= LEVEL_DOOR_LOCKED;
+                door.key = addString(tokens[6].text);
+            }
+            room->doors.push_back(door);
+            return true;
+        }
+
+        bool parseGuard(const std::vector<Token>& tokens) {
+            StagedRoom* room;
+            if (tokens.size() < 5) return fail("guard needs: room x y radius");
+            if (!findRoom(tokens[1], room)) return false;
+
+            StagedGuard guard{};
+            float values[3];
+            if (!parseFloats(tokens, 2, 3, values)) return false;
+            guard.record.x = values[0];
+            guard.record.y = values[1];
+            guard.record.radius = values[2];
+            if (tokens.size() > 5) {
+                if (tokens[5].text != "patrol" || (tokens.size() - 6) % 2 != 0) return fail("guard options are: patrol <x> <y> ...");
+                for (std::size_t i = 6; i < tokens.size(); i += 2) {
+                    float point[2];
+                    if (!parseFloats(tokens, i, 2, point)) return false;
+                    guard.points.push_back({point[0], point[1]});
+                }
+            }
+            room->guards.push_back(std::move(guard));
+            return true;
+        }
+
+        bool parsePuzzle(const std::vector<Token>& tokens) {
+            StagedRoom* room;
+            if (tokens.size() < 5) return fail("puzzle needs: room label kind ...");
+            if (!findRoom(tokens[1], room)) return false;
+
+            StagedPuzzle puzzle{};
+            puzzle.label = tokens[2].text;
+            for (const StagedPuzzle& other : room->puzzles) {
+                if (other.label == puzzle.label) return fail("puzzle label '" + puzzle.label + "' is used twice in one room");
+            }
+
+            const std::string& kind = tokens[3].text;
+            std::size_t next = 4;
+            if (kind == "riddle") {
+                if (tokens.size() < 6) return fail("riddle needs: text answer");
+                puzzle.record.kind = LEVEL_PUZZLE_RIDDLE;
+                puzzle.record.text = addString(tokens[4].text);
+                puzzle.record.answer = addString(tokens[5].text);
+                next = 6;
+            } else if (kind == "lock") {
+                puzzle.record.kind = LEVEL_PUZZLE_LOCK;
+                puzzle.record.answer = addString(tokens[4].text);
+                next = 5;
+            } else if (kind == "pattern") {
+                puzzle.record.kind = LEVEL_PUZZLE_PATTERN;
+                std::int32_t value;
+                while (next < tokens.size() && tokens[next].text != "prompt" && toInt(tokens[next], value)) {
+                    puzzle.pattern.push_back(value);
+                    next++;
+                }
+                if (puzzle.pattern.empty()) return fail("pattern needs at least one switch");
+            } else {
+                return fail("unknown puzzle kind '" + kind + "'");
+            }
+
+            if (next < tokens.size()) {
+                if (tokens[next].text != "prompt" || tokens.size() != next + 2) return fail("puzzle options are: prompt <text>");
+                puzzle.record.prompt = addString(tokens[next + 1].text);
+            }
+            room->puzzles.push_back(std::move(puzzle));
+            return true;
+        }
+
+        bool parseItem(const std::vector<Token>& tokens) {
+            StagedRoom* room;
+            if (tokens.size() < 7) return fail("item needs: room kind name value x y");
+            if (!findRoom(tokens[1], room)) return false;
+
+            StagedItem item{};
+            const std::string& kind = tokens[2].text;
+            if (kind == "key") item.record.kind = LEVEL_ITEM_KEY;
+            else if (kind == "passcode") item.record.kind = LEVEL_ITEM_PASSCODE;
+            else if (kind == "basic") item.record.kind = LEVEL_ITEM_BASIC;
+            else return fail("unknown item kind '" + kind + "'");
+
+            item.record.name = addString(tokens[3].text);
+            item.record.value = addString(tokens[4].text);
+            float position[2];
+            if (!parseFloats(tokens, 5, 2, position)) return false;
+            item.record.x = position[0];
+            item.record.y = position[1];
+            item.record.rewardOf = -1;
+            if (tokens.size() > 7) {
+                if (tokens[7].text != "reward" || tokens.size() != 9) return fail("item options are: reward <puzzle label>");
+                item.rewardLabel = tokens[8].text;
+            }
+            room->items.push_back(std::move(item));
+            return true;
+        }
+
+        bool parseObstacle(const std::vector<Token>& tokens) {
+            StagedRoom* room;
+            if (tokens.size() != 6) return fail("obstacle needs: room x y width height");
+            if (!findRoom(tokens[1], room)) return false;
+
+            float box[4];
+            if (!parseFloats(tokens, 2, 4, box)) return false;
+            if (box[2] <= 0.0f || box[3] <= 0.0f) return fail("obstacle width and height must be positive");
+            room->obstacles.push_back({box[0], box[1], box[2], box[3]});
+            return true;
+        }
+
+        // Lay the staged rooms out as contiguous per-room ranges
+        bool flatten() {
+            for (StagedRoom& room : rooms) {
+                LevelRoomRecord record = room.record;
+                record.firstDoor = static_cast<std::uint32_t>(level.doors.size());
+                record.doorCount = static_cast<std::uint32_t>(room.doors.size());
+                level.doors.insert(level.doors.end(), room.doors.begin(), room.doors.end());
+
+                record.firstGuard = static_cast<std::uint32_t>(level.guards.size());
+                record.guardCount = static_cast<std::uint32_t>(room.guards.size());
+                for (StagedGuard& guard : room.guards) {
+                    guard.record.firstPoint = static_cast<std::uint32_t>(level.points.size());
+                    guard.record.pointCount = static_cast<std::uint32_t>(guard.points.size());
+                    level.points.insert(level.points.end(), guard.points.begin(), guard.points.end());
+                    level.guards.push_back(guard.record);
+                }
+
+                record.firstPuzzle = static_cast<std::uint32_t>(level.puzzles.size());
+                record.puzzleCount = static_cast<std::uint32_t>(room.puzzles.size());
+                for (StagedPuzzle& puzzle : room.puzzles) {
+                    puzzle.record.firstPattern = static_cast<std::uint32_t>(level.patterns.size());
+                    puzzle.record.patternCount = static_cast<std::uint32_t>(puzzle.pattern.size());
+                    level.patterns.insert(level.patterns.end(), puzzle.pattern.begin(), puzzle.pattern.end());
+                    level.puzzles.push_back(puzzle.record);
+                }
+
+                record.firstItem = static_cast<std::uint32_t>(level.items.size());
+                record.itemCount = static_cast<std::uint32_t>(room.items.size());
+                for (StagedItem& item : room.items) {
+                    if (!item.rewardLabel.empty()) {
+                        for (std::size_t p = 0; p < room.puzzles.size(); p++) {
+                            if (room.puzzles[p].label == item.rewardLabel) item.record.rewardOf = static_cast<std::int32_t>(p);
+                        }
+                        if (item.record.rewardOf < 0) {
+                            return fail("reward '" + item.rewardLabel + "' names no puzzle in room " + std::to_string(record.id));
+                        }
+                    }
+                    level.items.push_back(item.record);
+                }
+
+                record.firstObstacle = static_cast<std::uint32_t>(level.obstacles.size());
+                record.obstacleCount = static_cast<std::uint32_t>(room.obstacles.size());
+                level.obstacles.insert(level.obstacles.end(), room.obstacles.begin(), room.obstacles.end());
+                level.rooms.push_back(record);
+            }
+            return true;
+        }
+
+    public:
+        TextParser(LevelData& target, std::string& errorOut) : level(target), error(errorOut) {}
+
+        bool parse(const std::string& text) {
+            level.clear();
+            std::istringstream input(text);
+            std::string line;
+            std::vector<Token> tokens;
+            bool hasStart = false;
+
+            for (int lineNumber = 1; std::getline(input, line); lineNumber++) {
+                std::string message;
+                bool ok = tokenize(line, tokens, message);
+                if (ok && !tokens.empty()) {
+                    const std::string& keyword = tokens[0].text;
+                    if (keyword == "start") {
+                        ok = tokens.size() == 2 && toInt(tokens[1], level.startRoom);
+                        if (!ok) message = "start needs: room";
+                        hasStart = ok;
+                    }
+                    else if (keyword == "room") ok = parseRoom(tokens);
+                    else if (keyword == "door") ok = parseDoor(tokens);
+                    else if (keyword == "guard") ok = parseGuard(tokens);
+                    else if (keyword == "puzzle") ok = parsePuzzle(tokens);
+                    else if (keyword == "item") ok = parseItem(tokens);
+                    else if (keyword == "obstacle") ok = parseObstacle(tokens);
+                    else { ok = false; message = "unknown statement '" + keyword + "'"; }
+                    if (!ok && message.empty()) message = error;
+                }
+                if (!ok) {
+                    error = "line " + std::to_string(lineNumber) + ": " + message;
+                    return false;
+                }
+            }
+
+            if (rooms.empty()) return fail("level has no rooms");
+            if (!hasStart) level.startRoom = rooms.front().record.id;
+            if (!roomIndex.count(level.startRoom)) return fail("start room " + std::to_string(level.startRoom) + " does not exist");
+            return flatten();
+        }
+    };
+
+    // Ranges in a loaded binary must stay inside their sections
+    bool validRange(std::uint32_t first, std::uint32_t count, std::size_t size) {
+        return first <= size && count <= size - first;
+    }
+}
+
+// ============================================================================
+// LevelData
+// ============================================================================
+
+const char* LevelData::string(std::uint32_t offset) const {
+    return offset < strings.size() ? strings.data() + offset : "";
+}
+
+int LevelData::findRoom(std::int32_t id) const {
+    for (std::size_t i = 0; i < rooms.size(); i++) {
+        if (rooms[i].id == id) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void LevelData::clear() {
+    startRoom = 1;
+    rooms.clear();
+    doors.clear();
+    guards.clear();
+    points.clear();
+    items.clear();
+    puzzles.clear();
+    patterns.clear();
+    strings.assign(1, '\0');
+    obstacles.clear();
+}
+
+// ============================================================================
+// LevelLoader
+// ============================================================================
+
+bool LevelLoader::load(const std::string& path, LevelData& level) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    if (!file.read(magic, 4) || std::memcmp(magic, MAGIC, 4) != 0) {
+        file.close();
+        return loadText(path, level);
+    }
+    file.close();
+    return loadBinary(path, level);
+}
+
+bool LevelLoader::loadText(const std::string& path, LevelData& level) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: Could not open level " << path << std::endl;
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    std::string error;
+    if (!parseText(contents.str(), level, error)) {
+        std::cerr << "Error: " << path << ", " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LevelLoader::parseText(const std::string& text, LevelData& level, std::string& error) {
+    TextParser parser(level, error);
+    return parser.parse(text);
+}
+
+bool LevelLoader::loadBinary(const std::string& path, LevelData& level) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    if (!loadBinary(file.getData(), file.getSize(), level)) {
+        std::cerr << "Error: " << path << " is not a valid level file." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LevelLoader::loadBinary(const std::uint8_t* data, std::size_t size, LevelData& level) {
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, 4) != 0) return false;
+    if (getFixed(data + 4, 2) != VERSION) return false;
+
+    std::uint32_t counts[SECTION_COUNT];
+    for (std::size_t i = 0; i < SECTION_COUNT; i++) counts[i] = static_cast<std::uint32_t>(getFixed(data + 12 + 4 * i, 4));
+    const std::size_t recordSizes[SECTION_COUNT] = {
+        sizeof(LevelRoomRecord), sizeof(LevelDoorRecord), sizeof(LevelGuardRecord), sizeof(LevelPointRecord),
+        sizeof(LevelItemRecord), sizeof(LevelPuzzleRecord), sizeof(std::int32_t), 1, sizeof(LevelObstacleRecord)
+    };
+    std::size_t expected = HEADER_SIZE;
+    for (std::size_t i = 0; i < SECTION_COUNT; i++) expected += static_cast<std::size_t>(counts[i]) * recordSizes[i];
+    if (expected != size || counts[7] == 0) return false;
+
+    level.startRoom = static_cast<std::int32_t>(getFixed(data + 8, 4));
+    const std::uint8_t* cursor = data + HEADER_SIZE;
+    copySection(cursor, counts[0], level.rooms);
+    copySection(cursor, counts[1], level.doors);
+    copySection(cursor, counts[2], level.guards);
+    copySection(cursor, counts[3], level.points);
+    copySection(cursor, counts[4], level.items);
+    copySection(cursor, counts[5], level.puzzles);
+    copySection(cursor, counts[6], level.patterns);
+    copySection(cursor, counts[7], level.strings);
+    copySection(cursor, counts[8], level.obstacles);
+    if (level.strings.back() != '\0') return false;
+
+    for (const LevelRoomRecord& room : level.rooms) {
+        if (!validRange(room.firstDoor, room.doorCount, level.doors.size()) ||
+            !validRange(room.firstGuard, room.guardCount, level.guards.size()) ||
+            !validRange(room.firstItem, room.itemCount, level.items.size()) ||
+            !validRange(room.firstPuzzle, room.puzzleCount, level.puzzles.size()) ||
+            !validRange(room.firstObstacle, room.obstacleCount, level.obstacles.size())) return false;
+    }
+    for (const LevelGuardRecord& guard : level.guards) {
+        if (!validRange(guard.firstPoint, guard.pointCount, level.points.size())) return false;
+    }
+    for (const LevelPuzzleRecord& puzzle : level.puzzles) {
+        if (!validRange(puzzle.firstPattern, puzzle.patternCount, level.patterns.size())) return false;
+    }
+    return true;
+}
+
+bool LevelLoader::saveBinary(const LevelData& level, const std::string& path) {
+    std::vector<std::uint8_t> out;
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    putFixed(out, VERSION, 2);
+    putFixed(out, 0, 2);
+    putFixed(out, static_cast<std::uint32_t>(level.startRoom), 4);
+    putFixed(out, level.rooms.size(), 4);
+    putFixed(out, level.doors.size(), 4);
+    putFixed(out, level.guards.size(), 4);
+    putFixed(out, level.points.size(), 4);
+    putFixed(out, level.items.size(), 4);
+    putFixed(out, level.puzzles.size(), 4);
+    putFixed(out, level.patterns.size(), 4);
+    putFixed(out, level.strings.size(), 4);
+    putFixed(out, level.obstacles.size(), 4);
+
+    appendSection(out, level.rooms);
+    appendSection(out, level.doors);
+    appendSection(out, level.guards);
+    appendSection(out, level.points);
+    appendSection(out, level.items);
+    appendSection(out, level.puzzles);
+    appendSection(out, level.patterns);
+    appendSection(out, level.strings);
+    appendSection(out, level.obstacles);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(reinterpret_cast<const char*>(out.data()), out.size())) {
+        std::cerr << "Error: Could not write level " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<Room> LevelLoader::buildRoom(const LevelData& level, std::size_t roomIndex, const sf::Texture& guardTexture) {
+    const LevelRoomRecord& record = level.rooms[roomIndex];
+    auto room = std::make_shared<Room>(record.id, level.string(record.name), record.x, record.y,
+                                       record.width, record.height, level.string(record.background));
+    room->setExitRoom((record.flags & LEVEL_ROOM_EXIT) != 0);
+
+    // Obstacles first: the room's navigation grid is built from them
+    for (std::uint32_t i = 0; i < record.obstacleCount; i++) {
+        const LevelObstacleRecord& obstacle = level.obstacles[record.firstObstacle + i];
+        room->addObstacle(sf::FloatRect({obstacle.x, obstacle.y}, {obstacle.width, obstacle.height}));
+    }
+
+    for (std::uint32_t i = 0; i < record.doorCount; i++) {
+        const LevelDoorRecord& door = level.doors[record.firstDoor + i];
+        room->addDoor(std::make_shared<Door>(door.x, door.y, door.targetRoom,
+                                             (door.flags & LEVEL_DOOR_LOCKED) != 0, level.string(door.key)));
+    }
+
+    for (std::uint32_t i = 0; i < record.guardCount; i++) {
+        const LevelGuardRecord& guardRecord = level.guards[record.firstGuard + i];
+        auto guard = std::make_shared<Guard>(guardRecord.x, guardRecord.y, guardRecord.radius, guardTexture);
+        for (std::uint32_t p = 0; p < guardRecord.pointCount; p++) {
+            const LevelPointRecord& point = level.points[guardRecord.firstPoint + p];
+            guard->addPatrolPoint(point.x, point.y);
+        }
+        room->addGuard(guard);
+    }
+
+    std::vector<std::shared_ptr<Puzzle>> puzzles;
+    for (std::uint32_t i = 0; i < record.puzzleCount; i++) {
+        const LevelPuzzleRecord& puzzleRecord = level.puzzles[record.firstPuzzle + i];
+        std::shared_ptr<Puzzle> puzzle;
+        switch (puzzleRecord.kind) {
+            case LEVEL_PUZZLE_RIDDLE:
+                puzzle = std::make_shared<RiddlePuzzle>(level.string(puzzleRecord.text), level.string(puzzleRecord.answer));
+                break;
+            case LEVEL_PUZZLE_PATTERN: {
+                auto first = level.patterns.begin() + puzzleRecord.firstPattern;
+                puzzle = std::make_shared<PatternPuzzle>(std::vector<int>(first, first + puzzleRecord.patternCount));
+                break;
+            }
+            default:
+                puzzle = std::make_shared<LockPuzzle>(level.string(puzzleRecord.answer));
+                break;
+        }
+        puzzle->setPrompt(level.string(puzzleRecord.prompt));
+        room->addPuzzle(puzzle);
+        puzzles.push_back(puzzle);
+    }
+
+    for (std::uint32_t i = 0; i < record.itemCount; i++) {
+        const LevelItemRecord& itemRecord = level.items[record.firstItem + i];
+        std::shared_ptr<Item> item;
+        switch (itemRecord.kind) {
+            case LEVEL_ITEM_KEY:
+                item = std::make_shared<Key>(level.string(itemRecord.name), level.string(itemRecord.value), itemRecord.x, itemRecord.y);
+                break;
+            case LEVEL_ITEM_PASSCODE:
+                item = std::make_shared<Passcode>(level.string(itemRecord.name), level.string(itemRecord.value), itemRecord.x, itemRecord.y);
+                break;
+            default:
+                item = std::make_shared<BasicItem>(level.string(itemRecord.name), level.string(itemRecord.value), itemRecord.x, itemRecord.y);
+                break;
+        }
+
+        // Rewards stay with their puzzle until it is solved
+        if (itemRecord.rewardOf >= 0 && static_cast<std::size_t>(itemRecord.rewardOf) < puzzles.size()) {
+            puzzles[itemRecord.rewardOf]->addReward(item);
+        } else {
+            room->addItem(item);
+        }
+    }
+    return room;
+}
+
+void LevelLoader::build(const LevelData& level, const sf::Texture& guardTexture, std::map<int, std::shared_ptr<Room>>& rooms) {
+    for (std::size_t i = 0; i < level.rooms.size(); i++) {
+        rooms[level.rooms[i].id] = buildRoom(level, i, guardTexture);
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Room;
+
+// Level data: flat arrays of fixed-size records, grouped by room. Every
+// field is 4 bytes and little-endian, so the binary form (.melv) is the
+// arrays written back to back and loads with one copy per section:
+//
+//   header:   "MELV" u16 version, u16 flags, i32 startRoom,
+//             u32 counts (rooms, doors, guards, patrol points, items,
+//             puzzles, pattern values, string bytes, obstacles)
+//   sections: rooms, doors, guards, patrol points, items, puzzles,
+//             pattern values, the string table, then obstacles
+//
+// Strings are byte offsets into the table (NUL-terminated; offset 0 is
+// the empty string). Each room names the contiguous range of doors,
+// guards, items, puzzles and obstacles it owns, so one room can be built
+// on its own.
+//
+// Text form (.level), one statement per line, '#' starts a comment,
+// strings in double quotes (\n, \" and \\ escapes):
+//
+//   start <room>
+//   room <id> <name> <x> <y> <width> <height> <background> [exit]
+//   door <room> <x> <y> <targetRoom> [locked <key>]
+//   guard <room> <x> <y> <radius> [patrol <x> <y> ...]
+//   puzzle <room> <label> riddle <text> <answer> [prompt <text>]
+//   puzzle <room> <label> pattern <switch> ... [prompt <text>]
+//   puzzle <room> <label> lock <code> [prompt <text>]
+//   item <room> key|passcode|basic <name> <value> <x> <y> [reward <label>]
+//   obstacle <room> <x> <y> <width> <height>
+//
+// An item's value is the door it opens (key), its code (passcode) or its
+// description (basic). Reward items appear when the labelled puzzle of
+// the same room is solved. Obstacles (walls, display cases) block the
+// player and are routed around by guards.
+
+struct LevelRoomRecord {
+    std::int32_t id;
+    std::uint32_t name;
+    float x, y, width, height;
+    std::uint32_t background;
+    std::uint32_t flags;
+    std::uint32_t firstDoor, doorCount;
+    std::uint32_t firstGuard, guardCount;
+    std::uint32_t firstItem, itemCount;
+    std::uint32_t firstPuzzle, puzzleCount;
+    std::uint32_t firstObstacle, obstacleCount;
+};
+
+struct LevelDoorRecord {
+    float x, y;
+    std::int32_t targetRoom;
+    std::uint32_t key;
+    std::uint32_t flags;
+};
+
+struct LevelGuardRecord {
+    float x, y, radius;
+    std::uint32_t firstPoint, pointCount;
+};
+
+struct LevelPointRecord {
+    float x, y;
+};
+
+struct LevelObstacleRecord {
+    float x, y, width, height;
+};
+
+struct LevelItemRecord {
+    std::uint32_t kind;
+    std::uint32_t name;
+    std::uint32_t value;
+    float x, y;
+    std::int32_t rewardOf; // Puzzle index within the room, or -1
+};
+
+struct LevelPuzzleRecord {
+    std::uint32_t kind;
+    std::uint32_t text;
+    std::uint32_t answer;
+    std::uint32_t prompt;
+    std::uint32_t firstPattern, patternCount;
+};
+
+// Record flags and kinds
+const std::uint32_t LEVEL_ROOM_EXIT = 1 << 0;
+const std::uint32_t LEVEL_DOOR_LOCKED = 1 << 0;
+
+enum LevelItemKind : std::uint32_t { LEVEL_ITEM_KEY, LEVEL_ITEM_PASSCODE, LEVEL_ITEM_BASIC };
+enum LevelPuzzleKind : std::uint32_t { LEVEL_PUZZLE_RIDDLE, LEVEL_PUZZLE_PATTERN, LEVEL_PUZZLE_LOCK };
+
+// LevelData - One level in memory, in exactly the binary layout
+struct LevelData {
+    std::int32_t startRoom = 1;
+    std::vector<LevelRoomRecord> rooms;
+    std::vector<LevelDoorRecord> doors;
+    std::vector<LevelGuardRecord> guards;
+    std::vector<LevelPointRecord> points;
+    std::vector<LevelItemRecord> items;
+    std::vector<LevelPuzzleRecord> puzzles;
+    std::vector<std::int32_t> patterns;
+    std::vector<char> strings; // Starts with the empty string
+    std::vector<LevelObstacleRecord> obstacles;
+
+    const char* string(std::uint32_t offset) const;
+    // Index into rooms of the room with this ID, or -1
+    int findRoom(std::int32_t id) const;
+    void clear();
+};
+
+// LevelLoader - Reads levels in either form and builds the room graph
+// (rooms, doors, guards, items, puzzles and their rewards) from them.
+class LevelLoader {
+public:
+    // Text or binary, told apart by the magic bytes
+    static bool load(const std::string& path, LevelData& level);
+
+    static bool loadText(const std::string& path, LevelData& level);
+    static bool parseText(const std::string& text, LevelData& level, std::string& error);
+
+    // The binary form is memory-mapped and copied out section by section
+    static bool loadBinary(const std::string& path, LevelData& level);
+    static bool loadBinary(const std::uint8_t* data, std::size_t size, LevelData& level);
+    static bool saveBinary(const LevelData& level, const std::string& path);
+
+    // Build one room (index into level.rooms) with everything it owns
+    static std::shared_ptr<Room> buildRoom(const LevelData& level, std::size_t roomIndex, const sf::Texture& guardTexture);
+    // Build every room of the level
+    static void build(const LevelData& level, const sf::Texture& guardTexture, std::map<int, std::shared_ptr<Room>>& rooms);
+};
+
+#endif // LEVEL_H
@@ -0,0 +1,225 @@
+/*
+ * Museum Escape - Lighting Pass Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "LightingPass.h"
+#include "Room.h"
+#include "NavGrid.h"
+#include "GuardSystem.h"
+#include "AssetCooker.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace {
+    const sf::Color AMBIENT(115, 115, 128);  // Unlit parts of the room
+    const float LANTERN_RADIUS = 70.0f;      // Warm pool around every guard
+    const float DEGREES_TO_RADIANS = 3.14159265f / 180.0f;
+
+    // Texture coordinates carry room coordinates straight through (SFML's
+    // texture matrix would rescale them if a texture were bound)
+    const char* const VERTEX_SOURCE = R"(
+#version 110
+varying vec2 world;
+
+void main() {
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    world = gl_MultiTexCoord0.xy;
+}
+)";
+
+    // Light i is texels 2i (center) and 2i + 1 (heading scaled to the
+    // detection range), unpacked as in packLight. Output is the light added
+    // on top of the ambient level, zero where every light is out of reach
+    // or its ray meets a blocked mask texel.
+    const char* const FRAGMENT_SOURCE = R"(
+uniform sampler2D lightData;
+uniform int lightCount;
+uniform vec2 roomSize;
+uniform float coneCos;
+uniform float lanternRadius;
+uniform sampler2D shadowMask;
+uniform vec2 maskOrigin;
+uniform vec2 maskSize;
+uniform float stepLength;
+varying vec2 world;
+
+const int MAX_STEPS = 32;
+const vec3 LANTERN = vec3(0.55, 0.45, 0.25);
+const vec3 CONE = vec3(0.6, 0.12, 0.08);
+
+vec2 unpack(float texel) {
+    vec4 bytes = texture2D(lightData, vec2((texel + 0.5) / float(LIGHTS * 2), 0.5)) * 255.0;
+    return vec2(bytes.r * 256.0 + bytes.g, bytes.b * 256.0 + bytes.a) / 65535.0;
+}
+
+float visible(vec2 from, vec2 to) {
+    vec2 delta = to - from;
+    float steps = min(ceil(length(delta) / stepLength), float(MAX_STEPS));
+    for (int i = 1; i < MAX_STEPS; i++) {
+        if (float(i) >= steps) break;
+        vec2 point = from + delta * (float(i) / steps);
+        if (texture2D(shadowMask, (point - maskOrigin) / maskSize).r > 0.5) return 0.0;
+    }
+    return 1.0;
+}
+
+void main() {
+    vec3 light = vec3(0.0);
+    for (int i = 0; i < LIGHTS; i++) {
+        if (i >= lightCount) break;
+        vec2 center = maskOrigin + unpack(float(i * 2)) * roomSize;
+        vec2 heading = (unpack(float(i * 2 + 1)) * 2.0 - 1.0) * roomSize;
+        vec2 offset = world - center;
+        float distance = length(offset);
+        float range = length(heading);
+        if (distance >= max(range, lanternRadius)) continue;
+
+        vec3 contribution = vec3(0.0);
+        if (distance < lanternRadius) {
+            float falloff = 1.0 - distance / lanternRadius;
+            contribution += LANTERN * falloff * falloff;
+        }
+        if (distance < range && dot(offset, heading) >= coneCos * distance * range) {
+            contribution += CONE * (1.0 - distance / range);
+        }
+        light += contribution * visible(center, world);
+    }
+    gl_FragColor = vec4(light, 1.0);
+}
+)";
+
+    // A fraction in [0, 1] as 16 bits, high byte first
+    void packFraction(std::uint8_t* bytes, float fraction) {
+        unsigned int value = static_cast<unsigned int>(std::lround(std::clamp(fraction, 0.0f, 1.0f) * 65535.0f));
+        bytes[0] = static_cast<std::uint8_t>(value >> 8);
+        bytes[1] = static_cast<std::uint8_t>(value & 0xFF);
+    }
+
+    // Two texels: the center as a fraction of the room (whose corner the
+    // shader knows as maskOrigin), then the heading as a fraction of twice
+    // the room's size, centered on 0.5
+    void packLight(std::uint8_t* texels, const sf::FloatRect& room, sf::Vector2f center, sf::Vector2f heading) {
+        packFraction(texels, (center.x - room.position.x) / room.size.x);
+        packFraction(texels + 2, (center.y - room.position.y) / room.size.y);
+        packFraction(texels + 4, heading.x / room.size.x * 0.5f + 0.5f);
+        packFraction(texels + 6, heading.y / room.size.y * 0.5f + 0.5f);
+    }
+}
+
+LightingPass::LightingPass()
+    : ready(false),
+      lightSprite(lightMap.getTexture()),
+      quad(sf::PrimitiveType::TriangleStrip, 4),
+      maskGrid(nullptr),
+      maskObstacles(0) {}
+
+bool LightingPass::load() {
+    if (!sf::Shader::isAvailable()) {
+        std::cerr << "Warning: Shaders unavailable; lighting disabled." << std::endl;
+        return false;
+    }
+    std::string fragment = "#version 110\n#define LIGHTS " + std::to_string(LIGHTS_PER_DRAW) + "\n" + FRAGMENT_SOURCE;
+    if (!shader.loadFromMemory(VERTEX_SOURCE, fragment)) {
+        std::cerr << "Error: Failed to compile the lighting shader." << std::endl;
+        return false;
+    }
+    if (!lightData.resize({static_cast<unsigned int>(LIGHTS_PER_DRAW) * TEXELS_PER_LIGHT, 1})) {
+        std::cerr << "Error: Failed to create the light texture." << std::endl;
+        return false;
+    }
+    lightData.setSmooth(false);
+    texels.resize(LIGHTS_PER_DRAW * TEXELS_PER_LIGHT * 4);
+    shader.setUniform("lightData", lightData);
+    shader.setUniform("coneCos", std::cos(GuardSystem::VISION_HALF_ANGLE * DEGREES_TO_RADIANS));
+    shader.setUniform("lanternRadius", LANTERN_RADIUS);
+    ready = true;
+    return true;
+}
+
+bool LightingPass::isReady() const { return ready; }
+
+// Size the light map and its quad to the room, and rebuild the shadow mask
+// when the room's obstacles changed. Nothing to do on a steady frame.
+bool LightingPass::prepare(const Room& room) {
+    sf::FloatRect bounds = room.getBounds();
+    sf::Vector2u mapSize(std::max(1u, static_cast<unsigned int>(std::ceil(bounds.size.x / LIGHT_MAP_SCALE))),
+                         std::max(1u, static_cast<unsigned int>(std::ceil(bounds.size.y / LIGHT_MAP_SCALE))));
+    if (lightMap.getSize() != mapSize) {
+        if (!lightMap.resize(mapSize)) {
+            std::cerr << "Error: Failed to create the light map." << std::endl;
+            ready = false;
+            return false;
+        }
+        lightMap.setSmooth(true);
+        lightSprite.setTexture(lightMap.getTexture(), true);
+    }
+    lightMap.setView(sf::View(bounds));
+    lightSprite.setPosition(bounds.position);
+    lightSprite.setScale({bounds.size.x / mapSize.x, bounds.size.y / mapSize.y});
+
+    sf::Vector2f corner = bounds.position + bounds.size;
+    quad[0] = {bounds.position, sf::Color::White, bounds.position};
+    quad[1] = {{corner.x, bounds.position.y}, sf::Color::White, {corner.x, bounds.position.y}};
+    quad[2] = {{bounds.position.x, corner.y}, sf::Color::White, {bounds.position.x, corner.y}};
+    quad[3] = {corner, sf::Color::White, corner};
+
+    if (maskGrid != &room.getSightGrid() || maskObstacles != room.getObstacles().size()) buildMask(room);
+    return true;
+}
+
+// One texel per sight-grid cell, white where blocked. Unfiltered, so a ray
+// is blocked exactly by the cells guards' sight is.
+void LightingPass::buildMask(const Room& room) {
+    const NavGrid& grid = room.getSightGrid();
+    sf::Vector2u size(static_cast<unsigned int>(grid.getColumns()), static_cast<unsigned int>(grid.getRows()));
+    sf::Image image(size, sf::Color::Black);
+    for (unsigned int row = 0; row < size.y; row++) {
+        for (unsigned int column = 0; column < size.x; column++) {
+            if (grid.isBlocked(static_cast<int>(column), static_cast<int>(row))) image.setPixel({column, row}, sf::Color::White);
+        }
+    }
+    if (!shadowMask.loadFromImage(image)) std::cerr << "Error: Failed to create the shadow mask." << std::endl;
+    shadowMask.setSmooth(false);
+    maskGrid = &grid;
+    maskObstacles = room.getObstacles().size();
+
+    shader.setUniform("shadowMask", shadowMask);
+    shader.setUniform("maskOrigin", room.getBounds().position);
+    shader.setUniform("roomSize", room.getBounds().size);
+    shader.setUniform("maskSize", sf::Glsl::Vec2(size.x * grid.getCellSize(), size.y * grid.getCellSize()));
+    shader.setUniform("stepLength", grid.getCellSize());
+}
+
+void LightingPass::draw(sf::RenderTarget& target, Room& room, float alpha) {
+    PROFILE_SCOPE("LightingPass::draw");
+    if (!ready || !prepare(room)) return;
+
+    // Where each guard is drawn this frame, and what it watches
+    GuardSystem& guards = room.getGuardSystem();
+    sf::FloatRect bounds = room.getBounds();
+    sf::RenderStates states(sf::BlendAdd);
+    states.shader = &shader;
+    lightMap.clear(AMBIENT);
+    for (std::size_t first = 0; first < guards.size(); first += LIGHTS_PER_DRAW) {
+        std::size_t last = std::min(guards.size(), first + LIGHTS_PER_DRAW);
+        for (std::size_t slot = first; slot < last; slot++) {
+            sf::Vector2f previous = guards.getPreviousPosition(slot);
+            sf::Vector2f center = previous + (guards.getPosition(slot) - previous) * alpha + CHARACTER_DISPLAY_SIZE / 2.0f;
+            sf::Vector2f heading = guards.getHeading(slot);
+            float length = std::sqrt(heading.x * heading.x + heading.y * heading.y);
+            heading = length > 0.0f ? heading * (guards.getRadius(slot) / length) : sf::Vector2f(guards.getRadius(slot), 0.0f);
+            packLight(&texels[(slot - first) * TEXELS_PER_LIGHT * 4], bounds, center, heading);
+        }
+        unsigned int count = static_cast<unsigned int>(last - first);
+        lightData.update(texels.data(), {count * TEXELS_PER_LIGHT, 1}, {0, 0});
+        shader.setUniform("lightCount", static_cast<int>(count));
+        lightMap.draw(quad, states);
+    }
+    lightMap.display();
+
+    target.draw(lightSprite, sf::BlendMultiply);
+}
@@ -0,0 +1,64 @@
+#ifndef LIGHTING_PASS_H
+#define LIGHTING_PASS_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Room;
+class NavGrid;
+
+// LightingPass - 2D lighting for a room: a dim ambient level, a lantern
+// around every guard and its vision cone, with shadows cast by the room's
+// obstacles. One fragment shader draws all lights at once into a
+// half-resolution light map, marching each lit pixel's ray over a shadow
+// mask holding one texel per sight-grid cell. The light map then multiplies
+// the scene. Lights (position, heading and range per guard) reach the
+// shader through a small texture updated in place each frame, as uniform
+// arrays are copied into a temporary on every upload.
+//
+// Needs shader support; when load() fails the caller draws the guards'
+// cones as shapes instead.
+class LightingPass {
+public:
+    // Lights the light texture holds; more take another draw
+    static constexpr std::size_t LIGHTS_PER_DRAW = 256;
+    // RGBA8 texels per light: the center, then the heading scaled to the
+    // range, each component as 16 bits of a fraction of the room's size
+    static constexpr unsigned int TEXELS_PER_LIGHT = 2;
+    static constexpr unsigned int LIGHT_MAP_SCALE = 2;  // Room pixels per light map pixel, per side
+
+private:
+    sf::Shader shader;
+    bool ready;
+
+    sf::RenderTexture lightMap; // Room-sized, LIGHT_MAP_SCALE times coarser
+    sf::Sprite lightSprite;     // Draws lightMap over the room
+    sf::VertexArray quad;   // Light map quad: texture coordinates in room coordinates
+
+    sf::Texture shadowMask;
+    const NavGrid* maskGrid; // Grid the mask was built from
+    std::size_t maskObstacles;
+
+    sf::Texture lightData;            // LIGHTS_PER_DRAW * TEXELS_PER_LIGHT by 1
+    std::vector<std::uint8_t> texels; // Its pixels, sized once in load()
+
+    bool prepare(const Room& room);
+    void buildMask(const Room& room);
+
+public:
+    // Constructor - not usable until load()
+    LightingPass();
+
+    // Compile the shader and create the light texture; false (and stays
+    // off) without shader support
+    bool load();
+    bool isReady() const;
+
+    // Light the room as drawn on target; alpha interpolates guard positions
+    // like the sprites
+    void draw(sf::RenderTarget& target, Room& room, float alpha);
+};
+
+#endif // LIGHTING_PASS_H
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// MappedFile - Read-only memory map of a whole file. The bytes are paged in
+// by the OS on first touch; nothing is copied up front.
+class MappedFile {
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    // Constructor
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    const std::uint8_t* getData() const;
+    std::size_t getSize() const;
+};
+
+#endif // MAPPED_FILE_H
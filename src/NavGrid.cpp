@@ -0,0 +1,129 @@
+/*
+ * Museum Escape - Navigation Grid Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+NavGrid::NavGrid()
+    : origin(0.0f, 0.0f),
+      cellSize(DEFAULT_CELL_SIZE),
+      columns(0),
+      rows(0),
+      blockedCount(0) {}
+
+void NavGrid::build(const sf::FloatRect& bounds, const std::vector<sf::FloatRect>& obstacles,
+                    const sf::Vector2f& agentSize, float cell) {
+    origin = bounds.position;
+    cellSize = cell;
+    columns = std::max(1, static_cast<int>(std::ceil(bounds.size.x / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(bounds.size.y / cellSize)));
+    blocked.assign(static_cast<std::size_t>(columns) * rows, 0);
+    blockedCount = 0;
+
+    for (const sf::FloatRect& obstacle : obstacles) {
+        // Every top-left corner from which an agent would overlap it
+        float left = obstacle.position.x - agentSize.x - origin.x;
+        float top = obstacle.position.y - agentSize.y - origin.y;
+        float right = obstacle.position.x + obstacle.size.x - origin.x;
+        float bottom = obstacle.position.y + obstacle.size.y - origin.y;
+
+        int firstColumn = std::max(0, static_cast<int>(std::floor(left / cellSize)));
+        int lastColumn = std::min(columns - 1, static_cast<int>(std::ceil(right / cellSize)) - 1);
+        int firstRow = std::max(0, static_cast<int>(std::floor(top / cellSize)));
+        int lastRow = std::min(rows - 1, static_cast<int>(std::ceil(bottom / cellSize)) - 1);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                std::uint8_t& flag = blocked[static_cast<std::size_t>(row) * columns + column];
+                if (!flag) blockedCount++;
+                flag = 1;
+            }
+        }
+    }
+}
+
+int NavGrid::getColumns() const { return columns; }
+int NavGrid::getRows() const { return rows; }
+std::size_t NavGrid::getCellCount() const { return blocked.size(); }
+float NavGrid::getCellSize() const { return cellSize; }
+bool NavGrid::hasObstacles() const { return blockedCount > 0; }
+
+int NavGrid::cellAt(const sf::Vector2f& point) const {
+    int column = static_cast<int>(std::floor((point.x - origin.x) / cellSize));
+    int row = static_cast<int>(std::floor((point.y - origin.y) / cellSize));
+    column = std::clamp(column, 0, columns - 1);
+    row = std::clamp(row, 0, rows - 1);
+    return row * columns + column;
+}
+
+sf::Vector2f NavGrid::centerOf(int cell) const {
+    int column = cell % columns;
+    int row = cell / columns;
+    return {origin.x + (column + 0.5f) * cellSize, origin.y + (row + 0.5f) * cellSize};
+}
+
+// Ring by ring outwards; the closest open cell of the first ring with any
+int NavGrid::nearestOpen(int cell) const {
+    if (!isBlocked(cell)) return cell;
+    int column = cell % columns;
+    int row = cell / columns;
+    int maxRadius = std::max(columns, rows);
+
+    for (int radius = 1; radius < maxRadius; radius++) {
+        int best = -1;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int dy = -radius; dy <= radius; dy++) {
+            // Whole rows at the ring's top and bottom, the two ends otherwise
+            int step = (dy == -radius || dy == radius) ? 1 : radius * 2;
+            for (int dx = -radius; dx <= radius; dx += step) {
+                if (isBlocked(column + dx, row + dy)) continue;
+                int distance = dx * dx + dy * dy;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = (row + dy) * columns + column + dx;
+                }
+            }
+        }
+        if (best >= 0) return best;
+    }
+    return -1;
+}
+
+// Grid traversal (Amanatides & Woo): every cell the segment passes through
+bool NavGrid::lineOfSight(const sf::Vector2f& from, const sf::Vector2f& to) const {
+    if (blockedCount == 0) return true;
+
+    const float infinity = std::numeric_limits<float>::infinity();
+    float startX = (from.x - origin.x) / cellSize;
+    float startY = (from.y - origin.y) / cellSize;
+    float endX = (to.x - origin.x) / cellSize;
+    float endY = (to.y - origin.y) / cellSize;
+    int column = static_cast<int>(std::floor(startX));
+    int row = static_cast<int>(std::floor(startY));
+    int steps = std::abs(static_cast<int>(std::floor(endX)) - column) + std::abs(static_cast<int>(std::floor(endY)) - row);
+
+    float dx = endX - startX;
+    float dy = endY - startY;
+    int stepX = dx > 0.0f ? 1 : -1;
+    int stepY = dy > 0.0f ? 1 : -1;
+    float deltaX = dx != 0.0f ? std::abs(1.0f / dx) : infinity;
+    float deltaY = dy != 0.0f ? std::abs(1.0f / dy) : infinity;
+    float nextX = dx > 0.0f ? (column + 1 - startX) * deltaX : dx < 0.0f ? (startX - column) * deltaX : infinity;
+    float nextY = dy > 0.0f ? (row + 1 - startY) * deltaY : dy < 0.0f ? (startY - row) * deltaY : infinity;
+
+    for (int i = 0;; i++) {
+        if (isBlocked(column, row)) return false;
+        if (i == steps) return true;
+        if (nextX < nextY) {
+            column += stepX;
+            nextX += deltaX;
+        } else {
+            row += stepY;
+            nextY += deltaY;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef NAV_GRID_H
+#define NAV_GRID_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// NavGrid - A room's walkable area as a grid of square cells, for guard
+// pathfinding. Obstacles are grown by the agent's size towards the top
+// left, so a cell is open exactly when an agent whose position (top-left
+// corner) is anywhere in it cannot touch an obstacle. Positions are in
+// room coordinates, like everything else in the simulation.
+class NavGrid {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 10.0f;
+
+private:
+    sf::Vector2f origin;
+    float cellSize;
+    int columns, rows;
+    std::vector<std::uint8_t> blocked; // Row major, 1 = blocked
+    std::size_t blockedCount;
+
+public:
+    // Constructor - an empty grid: no cells, nothing blocked
+    NavGrid();
+
+    // Rasterize obstacles over bounds (replaces the previous contents)
+    void build(const sf::FloatRect& bounds, const std::vector<sf::FloatRect>& obstacles,
+               const sf::Vector2f& agentSize, float cell = DEFAULT_CELL_SIZE);
+
+    int getColumns() const;
+    int getRows() const;
+    std::size_t getCellCount() const;
+    float getCellSize() const;
+    bool hasObstacles() const;
+
+    // Cell indices are row * columns + column. Inline: A* asks these for
+    // every neighbour of every node it expands.
+    bool isBlocked(int column, int row) const { // Outside the grid counts as blocked
+        if (column < 0 || row < 0 || column >= columns || row >= rows) return true;
+        return blocked[static_cast<std::size_t>(row) * columns + column] != 0;
+    }
+    bool isBlocked(int cell) const { return blocked[cell] != 0; }
+    int cellAt(const sf::Vector2f& point) const; // Clamped onto the grid
+    sf::Vector2f centerOf(int cell) const;
+    int nearestOpen(int cell) const; // The cell itself when open; -1 when none is
+
+    // No blocked cell along the segment (always true without obstacles)
+    bool lineOfSight(const sf::Vector2f& from, const sf::Vector2f& to) const;
+};
+
+#endif // NAV_GRID_H
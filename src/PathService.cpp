@@ -0,0 +1,295 @@
+/*
+ * Museum Escape - Path Service Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "PathService.h"
+#include "NavGrid.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+    const float DIAGONAL_COST = 1.41421356f;
+
+    // Eight neighbours: orthogonal first, then diagonal
+    const int NEIGHBOUR_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int NEIGHBOUR_Y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+    // Octile distance in cells: admissible and consistent for 8-way moves
+    float octile(int fromCell, int toCell, int columns) {
+        int dx = std::abs(fromCell % columns - toCell % columns);
+        int dy = std::abs(fromCell / columns - toCell / columns);
+        return static_cast<float>(dx + dy) + (DIAGONAL_COST - 2.0f) * static_cast<float>(std::min(dx, dy));
+    }
+
+    std::uint64_t cacheKey(int start, int goal) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(start)) << 32) | static_cast<std::uint32_t>(goal);
+    }
+}
+
+PathService::PathService()
+    : grid(nullptr),
+      nextTicket(1),
+      searching(false),
+      generation(0),
+      useCount(0),
+      cacheHits(0),
+      cacheMisses(0),
+      totalExpansions(0) {}
+
+void PathService::setGrid(const NavGrid* navGrid) {
+    grid = navGrid;
+    queue.clear();
+    results.clear();
+    searching = false;
+
+    std::size_t cells = grid ? grid->getCellCount() : 0;
+    seen.assign(cells, 0);
+    closed.assign(cells, 0);
+    cost.assign(cells, 0.0f);
+    parent.assign(cells, -1);
+    generation = 0;
+    clearCache();
+}
+
+const NavGrid* PathService::getGrid() const { return grid; }
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+PathService::Ticket PathService::request(const sf::Vector2f& from, const sf::Vector2f& to) {
+    Ticket ticket = nextTicket++;
+    if (nextTicket == NO_TICKET) nextTicket = 1;
+
+    Request job{ticket, -1, -1, to, false};
+    if (grid && grid->getCellCount() > 0) {
+        int goalCell = grid->cellAt(to);
+        job.start = grid->nearestOpen(grid->cellAt(from));
+        job.goal = grid->nearestOpen(goalCell);
+        job.exact = job.goal == goalCell;
+    }
+    if (job.start < 0 || job.goal < 0) {
+        deliver(job, false, {});
+        return ticket;
+    }
+    if (job.start == job.goal) {
+        deliver(job, true, {});
+        return ticket;
+    }
+
+    if (CacheEntry* entry = findCached(cacheKey(job.start, job.goal))) {
+        cacheHits++;
+        deliver(job, entry->found, entry->path);
+        return ticket;
+    }
+    cacheMisses++;
+    queue.push_back(job);
+    return ticket;
+}
+
+PathService::Status PathService::poll(Ticket ticket, std::vector<sf::Vector2f>& path) {
+    for (auto it = results.begin(); it != results.end(); ++it) {
+        if (it->ticket != ticket) continue;
+        bool found = it->found;
+        path = std::move(it->path);
+        results.erase(it);
+        return found ? Status::READY : Status::FAILED;
+    }
+    for (const Request& job : queue) {
+        if (job.ticket == ticket) return Status::PENDING;
+    }
+    return Status::UNKNOWN;
+}
+
+void PathService::cancel(Ticket ticket) {
+    if (ticket == NO_TICKET) return;
+    for (auto it = results.begin(); it != results.end(); ++it) {
+        if (it->ticket == ticket) {
+            results.erase(it);
+            return;
+        }
+    }
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (it->ticket == ticket) {
+            if (it == queue.begin()) searching = false; // Abandon the partial search
+            queue.erase(it);
+            return;
+        }
+    }
+}
+
+// Waypoints are cell centers; the last one becomes the exact target when
+// the target is reachable, otherwise the path stops at the nearest open cell
+void PathService::deliver(const Request& request, bool found, const std::vector<sf::Vector2f>& path) {
+    Result result{request.ticket, found, path};
+    if (found) {
+        if (result.path.empty()) result.path.push_back(request.exact ? request.target : grid->centerOf(request.goal));
+        else if (request.exact) result.path.back() = request.target;
+    }
+    results.push_back(std::move(result));
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+void PathService::update(std::size_t budget) {
+    if (queue.empty()) return;
+    PROFILE_SCOPE("PathService::update");
+    while (budget > 0 && !queue.empty()) {
+        if (!searching) {
+            // An earlier search in the queue may have answered this one
+            const Request& next = queue.front();
+            if (CacheEntry* entry = findCached(cacheKey(next.start, next.goal))) {
+                deliver(next, entry->found, entry->path);
+                queue.pop_front();
+                continue;
+            }
+            beginSearch(next);
+        }
+
+        bool found = false;
+        if (!expand(queue.front(), budget, found)) return; // Out of budget: resume next tick
+        finishSearch(queue.front(), found);
+        queue.pop_front();
+        searching = false;
+    }
+}
+
+void PathService::beginSearch(const Request& request) {
+    if (++generation == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(closed.begin(), closed.end(), 0);
+        generation = 1;
+    }
+    open.clear();
+    seen[request.start] = generation;
+    cost[request.start] = 0.0f;
+    parent[request.start] = -1;
+    open.push_back({octile(request.start, request.goal, grid->getColumns()), 0.0f, request.start});
+    searching = true;
+}
+
+bool PathService::expand(const Request& request, std::size_t& budget, bool& found) {
+    // Min-heap on f; ties go to the deeper node, which reaches the goal sooner
+    auto after = [](const OpenNode& a, const OpenNode& b) {
+        return a.f > b.f || (a.f == b.f && a.g < b.g);
+    };
+    const int columns = grid->getColumns();
+
+    while (!open.empty()) {
+        if (budget == 0) return false;
+        std::pop_heap(open.begin(), open.end(), after);
+        OpenNode node = open.back();
+        open.pop_back();
+        if (closed[node.cell] == generation) continue; // Stale entry
+        closed[node.cell] = generation;
+        budget--;
+        totalExpansions++;
+
+        if (node.cell == request.goal) {
+            found = true;
+            return true;
+        }
+
+        int column = node.cell % columns;
+        int row = node.cell / columns;
+        for (int i = 0; i < 8; i++) {
+            int dx = NEIGHBOUR_X[i];
+            int dy = NEIGHBOUR_Y[i];
+            if (grid->isBlocked(column + dx, row + dy)) continue;
+            bool diagonal = dx != 0 && dy != 0;
+            // No cutting corners: both cells beside a diagonal step must be open
+            if (diagonal && (grid->isBlocked(column + dx, row) || grid->isBlocked(column, row + dy))) continue;
+
+            int next = (row + dy) * columns + column + dx;
+            if (closed[next] == generation) continue;
+            float g = node.g + (diagonal ? DIAGONAL_COST : 1.0f);
+            if (seen[next] == generation && !(g < cost[next])) continue;
+
+            seen[next] = generation;
+            cost[next] = g;
+            parent[next] = node.cell;
+            open.push_back({g + octile(next, request.goal, columns), g, next});
+            std::push_heap(open.begin(), open.end(), after);
+        }
+    }
+    found = false;
+    return true;
+}
+
+void PathService::finishSearch(const Request& request, bool found) {
+    std::vector<sf::Vector2f> path;
+    if (found) smooth(request.start, request.goal, path);
+    storeCached(cacheKey(request.start, request.goal), found, path);
+    deliver(request, found, path);
+}
+
+// String pulling: keep only the turns of the cell path, then skip every
+// turn the previous kept point can see past
+void PathService::smooth(int start, int goal, std::vector<sf::Vector2f>& out) const {
+    std::vector<int> cells;
+    for (int cell = goal; cell != start; cell = parent[cell]) cells.push_back(cell);
+    cells.push_back(start);
+    std::reverse(cells.begin(), cells.end());
+
+    std::vector<int> turns{cells.front()};
+    for (std::size_t i = 1; i + 1 < cells.size(); i++) {
+        if (cells[i] - cells[i - 1] != cells[i + 1] - cells[i]) turns.push_back(cells[i]);
+    }
+    turns.push_back(cells.back());
+
+    out.clear();
+    std::size_t anchor = 0;
+    while (anchor + 1 < turns.size()) {
+        std::size_t reach = anchor + 1;
+        sf::Vector2f from = grid->centerOf(turns[anchor]);
+        while (reach + 1 < turns.size() && grid->lineOfSight(from, grid->centerOf(turns[reach + 1]))) reach++;
+        out.push_back(grid->centerOf(turns[reach]));
+        anchor = reach;
+    }
+}
+
+bool PathService::findPath(const sf::Vector2f& from, const sf::Vector2f& to, std::vector<sf::Vector2f>& path) {
+    Ticket ticket = request(from, to);
+    update(std::numeric_limits<std::size_t>::max());
+    return poll(ticket, path) == Status::READY;
+}
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+PathService::CacheEntry* PathService::findCached(std::uint64_t key) {
+    for (CacheEntry& entry : cache) {
+        if (entry.key == key) {
+            entry.lastUsed = ++useCount;
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void PathService::storeCached(std::uint64_t key, bool found, const std::vector<sf::Vector2f>& path) {
+    if (cache.size() < CACHE_CAPACITY) {
+        cache.push_back({key, found, path, ++useCount});
+        return;
+    }
+    auto oldest = std::min_element(cache.begin(), cache.end(), [](const CacheEntry& a, const CacheEntry& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    *oldest = {key, found, path, ++useCount};
+}
+
+void PathService::clearCache() {
+    cache.clear();
+    useCount = 0;
+}
+
+std::size_t PathService::getPendingCount() const { return queue.size(); }
+std::size_t PathService::getCacheHits() const { return cacheHits; }
+std::size_t PathService::getCacheMisses() const { return cacheMisses; }
+std::size_t PathService::getTotalExpansions() const { return totalExpansions; }
@@ -0,0 +1,116 @@
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class NavGrid;
+
+// PathService - A* over a room's NavGrid for its guards. Requests queue up
+// and are searched a slice at a time: update() expands at most a fixed
+// number of nodes per tick, so a long search is spread over several ticks
+// instead of spiking one. The budget counts nodes, not time, so results
+// land on the same tick in every run and replays stay exact.
+//
+// Finished paths are string-pulled into a few waypoints and kept in a small
+// LRU cache by (start cell, goal cell); patrols repeat the same legs, so
+// most requests are answered there without searching at all.
+class PathService {
+public:
+    typedef std::uint32_t Ticket;
+    static constexpr Ticket NO_TICKET = 0;
+    static constexpr std::size_t EXPANSIONS_PER_TICK = 512;  // A typical room path: one slice
+    static constexpr std::size_t CACHE_CAPACITY = 64;
+
+    enum class Status {
+        PENDING, // Queued or being searched
+        READY,   // Path handed out (the ticket is spent)
+        FAILED,  // No path (the ticket is spent)
+        UNKNOWN  // Spent, cancelled or never issued
+    };
+
+private:
+    struct Request {
+        Ticket ticket;
+        int start, goal;
+        sf::Vector2f target; // Exact goal position
+        bool exact;          // Target is inside the goal cell: end on it
+    };
+
+    struct Result {
+        Ticket ticket;
+        bool found;
+        std::vector<sf::Vector2f> path;
+    };
+
+    struct CacheEntry {
+        std::uint64_t key;
+        bool found;
+        std::vector<sf::Vector2f> path; // Waypoints as cell centers, start excluded
+        unsigned long long lastUsed;
+    };
+
+    struct OpenNode {
+        float f, g;
+        std::int32_t cell;
+    };
+
+    const NavGrid* grid;
+    std::deque<Request> queue;
+    std::vector<Result> results;
+    Ticket nextTicket;
+
+    // Search state of queue.front(); arrays are stamped with the search's
+    // generation so nothing is cleared between searches
+    bool searching;
+    std::uint32_t generation;
+    std::vector<std::uint32_t> seen, closed;
+    std::vector<float> cost;
+    std::vector<std::int32_t> parent;
+    std::vector<OpenNode> open;
+
+    std::vector<CacheEntry> cache;
+    unsigned long long useCount;
+    std::size_t cacheHits, cacheMisses;
+    std::size_t totalExpansions;
+
+    void beginSearch(const Request& request);
+    bool expand(const Request& request, std::size_t& budget, bool& found); // True once the search is over
+    void finishSearch(const Request& request, bool found);
+    void smooth(int start, int goal, std::vector<sf::Vector2f>& out) const;
+
+    CacheEntry* findCached(std::uint64_t key);
+    void storeCached(std::uint64_t key, bool found, const std::vector<sf::Vector2f>& path);
+    void deliver(const Request& request, bool found, const std::vector<sf::Vector2f>& path);
+
+public:
+    // Constructor - no grid yet: every request fails
+    PathService();
+
+    // Search this grid; drops queued requests, finished results and the cache
+    void setGrid(const NavGrid* navGrid);
+    const NavGrid* getGrid() const;
+
+    // Queue a path between two positions. A cached leg is ready at once.
+    Ticket request(const sf::Vector2f& from, const sf::Vector2f& to);
+    // READY fills path with the waypoints after from, ending exactly at to
+    Status poll(Ticket ticket, std::vector<sf::Vector2f>& path);
+    void cancel(Ticket ticket);
+
+    // Search queued requests for up to budget node expansions; once per tick
+    void update(std::size_t budget = EXPANSIONS_PER_TICK);
+
+    // Immediate, unbudgeted search (tools and tests; goes through the cache)
+    bool findPath(const sf::Vector2f& from, const sf::Vector2f& to, std::vector<sf::Vector2f>& path);
+
+    void clearCache();
+    std::size_t getPendingCount() const;
+    std::size_t getCacheHits() const;
+    std::size_t getCacheMisses() const;
+    std::size_t getTotalExpansions() const;
+};
+
+#endif // PATH_SERVICE_H
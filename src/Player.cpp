@@ -5,11 +5,14 @@
 
 #include "Player.h"
 #include "Item.h"
-#include <SFML/Window/Keyboard.hpp>
+#include "SpriteBatch.h"
+#include "AssetCooker.h"
+#include "Input.h"
 
 // Constructor - CHANGED to use Texture
 Player::Player(float x, float y, const sf::Texture& texture) 
     : position(x, y),
+      previousPosition(x, y),
       sprite(texture),  // <--- FIX: Initialize sprite HERE with the texture
       speed(200.0f),
       health(100),
@@ -19,8 +22,11 @@ Player::Player(float x, float y, const sf::Texture& texture)
     
     sprite.setPosition(position);
     
-    // If the sprite is too big, you can scale it here:
-    sprite.setScale({0.05f, 0.05f}); 
+    // Scale whatever texture we got (cooked or fallback) to the display size
+    sf::Vector2u texSize = texture.getSize();
+    if (texSize.x > 0 && texSize.y > 0) {
+        sprite.setScale({CHARACTER_DISPLAY_SIZE.x / texSize.x, CHARACTER_DISPLAY_SIZE.y / texSize.y});
+    }
 }
 
 // Move player by delta amounts
@@ -30,28 +36,16 @@ void Player::move(float dx, float dy) {
     sprite.setPosition(position);
 }
 
-// Handle keyboard input for movement
-void Player::handleInput(float deltaTime) {
+// Apply the movement keys held this tick (sampled by whoever drives us:
+// the keyboard in Game, a script when headless)
+void Player::handleInput(const PlayerInput& input, float deltaTime) {
     float moveX = 0.0f;
     float moveY = 0.0f;
     
-    // Check WASD keys
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up)) {
-        moveY -= speed * deltaTime;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down)) {
-        moveY += speed * deltaTime;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left)) {
-        moveX -= speed * deltaTime;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)) {
-        moveX += speed * deltaTime;
-    }
+    if (input.up) moveY -= speed * deltaTime;
+    if (input.down) moveY += speed * deltaTime;
+    if (input.left) moveX -= speed * deltaTime;
+    if (input.right) moveX += speed * deltaTime;
     
     // Apply movement
     if (moveX != 0.0f || moveY != 0.0f) {
@@ -66,44 +60,69 @@ void Player::setPosition(float x, float y) {
     sprite.setPosition(position);
 }
 
+void Player::teleport(float x, float y) {
+    setPosition(x, y);
+    previousPosition = position;
+}
+
 // Get player position
 sf::Vector2f Player::getPosition() const {
     return position;
 }
 
+// Remember the current position as the start of the next tick
+void Player::savePreviousPosition() {
+    previousPosition = position;
+}
+
+sf::Vector2f Player::getPreviousPosition() const { return previousPosition; }
+
+// Move the sprite (only) between the previous and current tick position
+void Player::interpolate(float alpha) {
+    sprite.setPosition(previousPosition + (position - previousPosition) * alpha);
+}
+
 // Check collision with bounds
 bool Player::checkCollision(const sf::FloatRect& bounds) {
-    return sprite.getGlobalBounds().findIntersection(bounds).has_value();
+    return getBounds().findIntersection(bounds).has_value();
 }
 
-// Get player bounding box
+// Get player bounding box (simulation position and size, independent of
+// the interpolated sprite or whether a texture is loaded at all)
 sf::FloatRect Player::getBounds() const {
-    return sprite.getGlobalBounds();
+    return sf::FloatRect(position, CHARACTER_DISPLAY_SIZE);
 }
 
 // Add item to inventory
 void Player::addItem(Item* item) {
     inventory.push_back(item);
+    heldItems.insert(item->getId());
 }
 
-// Check if player has specific item
-bool Player::hasItem(const std::string& itemName) {
-    for (const auto& item : inventory) {
-        if (item->getName() == itemName) {
-            return true;
-        }
-    }
-    return false;
+// Check if player has specific item (NO_ITEM is never held)
+bool Player::hasItem(ItemId id) const {
+    return id != NO_ITEM && heldItems.contains(id);
+}
+
+bool Player::hasItem(const std::string& itemName) const {
+    return hasItem(ItemRegistry::global().find(itemName));
 }
 
 // Remove item from inventory
-void Player::removeItem(const std::string& itemName) {
+void Player::removeItem(ItemId id) {
     for (auto it = inventory.begin(); it != inventory.end(); ++it) {
-        if ((*it)->getName() == itemName) {
+        if ((*it)->getId() == id) {
             inventory.erase(it);
-            return;
+            break;
         }
     }
+    // Keep the bit if a second copy is still carried
+    heldItems.erase(id);
+    for (const auto* item : inventory) if (item->getId() == id) heldItems.insert(id);
+}
+
+void Player::removeItem(const std::string& itemName) {
+    removeItem(ItemRegistry::global().find(itemName));
 }
 
 // Get inventory reference
@@ -127,8 +146,13 @@ void Player::resetWarning() {
 }
 
 // Draw player
-void Player::draw(sf::RenderWindow& window) {
-    window.draw(sprite);
+void Player::draw(sf::RenderTarget& target) {
+    target.draw(sprite);
+}
+
+// Queue player into the sprite batch
+void Player::draw(SpriteBatch& batch) {
+    batch.add(sprite);
 }
 
 // Update player (for animations, etc.)
@@ -4,18 +4,24 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
+#include "ItemRegistry.h"
+
+struct PlayerInput;
 
 class Item; // Forward declaration
 class Room; // Forward declaration
+class SpriteBatch;
 
 class Player {
 private:
     sf::Vector2f position;
+    sf::Vector2f previousPosition; // Position at the start of the current tick
     sf::Sprite sprite; // CHANGED: Now a Sprite
     float speed;
     int health;
     bool isWarned; // True if caught by guard once
     std::vector<Item*> inventory;
+    ItemSet heldItems; // O(1) key checks by interned ID
     
 public:
     // Constructor - CHANGED: Takes texture
@@ -23,17 +29,25 @@ public:
     
     // Movement
     void move(float dx, float dy);
-    void handleInput(float deltaTime);
-    void setPosition(float x, float y);
+    void handleInput(const PlayerInput& input, float deltaTime);
+    void setPosition(float x, float y); // Within the tick (collision): still interpolated
+    void teleport(float x, float y);    // Jump: nothing to blend from
     sf::Vector2f getPosition() const;
     
+    // Render interpolation (fixed-step simulation)
+    void savePreviousPosition();
+    sf::Vector2f getPreviousPosition() const;
+    void interpolate(float alpha);
+    
     // Collision
     bool checkCollision(const sf::FloatRect& bounds);
     sf::FloatRect getBounds() const;
     
     // Inventory management
     void addItem(Item* item);
-    bool hasItem(const std::string& itemName);
+    bool hasItem(ItemId id) const;
+    bool hasItem(const std::string& itemName) const;
+    void removeItem(ItemId id);
     void removeItem(const std::string& itemName);
     std::vector<Item*>& getInventory();
     
@@ -43,7 +57,8 @@ public:
     void resetWarning();
     
     // Rendering
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderTarget& target);
+    void draw(SpriteBatch& batch);
     void update(float deltaTime);
 };
 
@@ -0,0 +1,157 @@
+/*
+ * Museum Escape - Profiler Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+
+    // Nanoseconds as the microseconds Chrome traces use, keeping the fraction
+    void writeMicroseconds(std::ostream& out, std::int64_t nanoseconds) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+        out << buffer;
+    }
+}
+
+Profiler::Profiler()
+    : epoch(Clock::now()),
+      frameTimes(FRAME_HISTORY, 0.0f),
+      nextFrame(0)
+{
+    sortedFrames.reserve(FRAME_HISTORY);
+}
+
+Profiler& Profiler::global() {
+    static Profiler profiler;
+    return profiler;
+}
+
+std::int64_t Profiler::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+// First use on a thread registers its ring; later uses are one TLS read
+Profiler::ThreadRing& Profiler::localRing() {
+    thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        auto created = std::make_unique<ThreadRing>();
+        created->samples.resize(RING_CAPACITY);
+        std::lock_guard<std::mutex> lock(mutex);
+        created->threadId = static_cast<std::uint32_t>(rings.size() + 1);
+        created->threadName = "Thread " + std::to_string(created->threadId);
+        ring = created.get();
+        rings.push_back(std::move(created));
+    }
+    return *ring;
+}
+
+void Profiler::record(const char* name, std::int64_t start, std::int64_t end) {
+    ThreadRing& ring = localRing();
+    std::lock_guard<std::mutex> lock(ring.mutex);
+    ring.samples[ring.next] = {name, start, end - start};
+    ring.next = (ring.next + 1) % RING_CAPACITY;
+    if (ring.count < RING_CAPACITY) ring.count++;
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadRing& ring = localRing();
+    std::lock_guard<std::mutex> lock(ring.mutex);
+    ring.threadName = name;
+}
+
+void Profiler::endFrame(float seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    frameTimes[nextFrame % FRAME_HISTORY] = seconds * 1000.0f;
+    nextFrame++;
+}
+
+// Sorts in a member buffer (under the lock, which also guards it) so the
+// overlay's refresh does not allocate
+Profiler::FrameStats Profiler::getFrameStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<float>& sorted = sortedFrames;
+    std::size_t count = std::min(nextFrame, FRAME_HISTORY);
+    sorted.assign(frameTimes.begin(), frameTimes.begin() + count);
+
+    FrameStats stats;
+    stats.frames = sorted.size();
+    if (sorted.empty()) return stats;
+    std::sort(sorted.begin(), sorted.end());
+    // Nearest rank: the smallest sample with at least p% of frames at or below it
+    auto percentile = [&](float p) {
+        std::size_t rank = static_cast<std::size_t>(p * sorted.size() + 0.999f);
+        return sorted[std::min(std::max<std::size_t>(rank, 1), sorted.size()) - 1];
+    };
+    stats.p50 = percentile(0.50f);
+    stats.p99 = percentile(0.99f);
+    stats.max = sorted.back();
+    return stats;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: Could not write " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::size_t written = 0;
+    for (const auto& ring : rings) {
+        std::lock_guard<std::mutex> ringLock(ring->mutex);
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+            << ",\"args\":{\"name\":";
+        writeJsonString(out, ring->threadName.c_str());
+        out << "}}";
+        first = false;
+
+        // Oldest first
+        std::size_t oldest = (ring->next + RING_CAPACITY - ring->count) % RING_CAPACITY;
+        for (std::size_t i = 0; i < ring->count; i++) {
+            const Sample& sample = ring->samples[(oldest + i) % RING_CAPACITY];
+            out << ",\n{\"name\":";
+            writeJsonString(out, sample.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->threadId << ",\"ts\":";
+            writeMicroseconds(out, sample.start);
+            out << ",\"dur\":";
+            writeMicroseconds(out, sample.duration);
+            out << "}";
+        }
+        written += ring->count;
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        std::cerr << "Error: Could not write " << path << std::endl;
+        return false;
+    }
+    std::cout << "Profile: " << written << " scopes from " << rings.size() << " threads written to " << path << std::endl;
+    return true;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& ring : rings) {
+        std::lock_guard<std::mutex> ringLock(ring->mutex);
+        ring->next = 0;
+        ring->count = 0;
+    }
+    std::fill(frameTimes.begin(), frameTimes.end(), 0.0f);
+    nextFrame = 0;
+}
@@ -0,0 +1,120 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Profiling is on in debug builds and compiled out when NDEBUG is set.
+// Define PROFILER_ENABLED to 1 or 0 to override either way.
+#ifndef PROFILER_ENABLED
+#ifdef NDEBUG
+#define PROFILER_ENABLED 0
+#else
+#define PROFILER_ENABLED 1
+#endif
+#endif
+
+// Profiler - Scoped wall-clock timings for finding where frame time goes.
+// Each thread writes its scopes to its own fixed-size ring buffer (the
+// oldest samples are overwritten), so recording never allocates and never
+// contends with other threads. exportChromeTrace() writes everything still
+// in the rings as Chrome trace JSON (chrome://tracing or Perfetto).
+// The frame-time history behind the overlay's p50/p99/max lives here too.
+// Use the PROFILE_* macros below rather than calling this directly.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const std::size_t RING_CAPACITY = 32768; // Samples per thread
+    static const std::size_t FRAME_HISTORY = 240;   // Frames behind the percentiles
+
+    struct Sample {
+        const char* name; // String literal: only the pointer is stored
+        std::int64_t start;    // Nanoseconds since the profiler started
+        std::int64_t duration; // Nanoseconds
+    };
+
+    struct FrameStats {
+        float p50 = 0.0f; // Milliseconds
+        float p99 = 0.0f;
+        float max = 0.0f;
+        std::size_t frames = 0;
+    };
+
+private:
+    struct ThreadRing {
+        std::mutex mutex; // Taken by the owning thread (uncontended) and by exports
+        std::vector<Sample> samples;
+        std::size_t next = 0;
+        std::size_t count = 0;
+        std::uint32_t threadId = 0;
+        std::string threadName;
+    };
+
+    Clock::time_point epoch;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings; // One per thread that ever recorded
+    std::vector<float> frameTimes; // Ring of FRAME_HISTORY, in milliseconds
+    std::size_t nextFrame;
+    mutable std::vector<float> sortedFrames; // getFrameStats scratch, FRAME_HISTORY reserved
+
+    ThreadRing& localRing();
+
+public:
+    // Constructor
+    Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    std::int64_t now() const; // Nanoseconds since the profiler started
+    void record(const char* name, std::int64_t start, std::int64_t end);
+    void setThreadName(const std::string& name); // Shown in the trace viewer
+
+    void endFrame(float seconds);
+    FrameStats getFrameStats() const;
+
+    bool exportChromeTrace(const std::string& path) const;
+    void clear();
+
+    // Profiler shared by every thread
+    static Profiler& global();
+};
+
+// ProfileScope - Times its own lifetime into the global profiler
+class ProfileScope {
+private:
+    const char* name;
+    std::int64_t start;
+
+public:
+    explicit ProfileScope(const char* scopeName)
+        : name(scopeName),
+          start(Profiler::global().now())
+    {
+    }
+    ~ProfileScope() { Profiler::global().record(name, start, Profiler::global().now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::global().setThreadName(name)
+#define PROFILE_FRAME(seconds) Profiler::global().endFrame(seconds)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_FRAME(seconds) ((void)0)
+#endif
+
+#endif // PROFILER_H
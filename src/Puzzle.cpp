@@ -4,19 +4,38 @@
  */
 
 #include "Puzzle.h"
+#include "EventBus.h"
+#include "Room.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <cctype>
 
 // Puzzle Base Class
 Puzzle::Puzzle(const std::string& desc, const std::string& hintText, int bonus, int penalty)
-    : isSolved(false), description(desc), hint(hintText), timeBonus(bonus), timePenalty(penalty) {}
+    : isSolved(false), description(desc), hint(hintText), timeBonus(bonus), timePenalty(penalty),
+      owner(nullptr) {}
 
 bool Puzzle::isSolvedStatus() const { return isSolved; }
 std::string Puzzle::getDescription() const { return description; }
 std::string Puzzle::getHint() const { return hint; }
 int Puzzle::getTimeBonus() const { return timeBonus; }
 int Puzzle::getTimePenalty() const { return timePenalty; }
-void Puzzle::setSolved(bool status) { isSolved = status; }
+int Puzzle::getRoomID() const { return owner ? owner->getRoomID() : -1; }
+void Puzzle::setOwner(Room* room) { owner = room; }
+void Puzzle::setPrompt(const std::string& text) { prompt = text; }
+const std::string& Puzzle::getPrompt() const { return prompt; }
+void Puzzle::addReward(std::shared_ptr<Item> item) { rewards.push_back(item); }
+const std::vector<std::shared_ptr<Item>>& Puzzle::getRewards() const { return rewards; }
+
+void Puzzle::setSolved(bool status) {
+    if (status == isSolved) return;
+    isSolved = status;
+    if (!owner) return;
+    
+    owner->onPuzzleSolvedChanged(isSolved);
+    EventBus* events = owner->getEventBus();
+    if (isSolved && events) events->publish(GameEvent::Type::PUZZLE_SOLVED, NO_ITEM, owner->getRoomID());
+}
 
 // ============================================================================
 // RiddlePuzzle - Fully Interactive
@@ -26,9 +45,9 @@ RiddlePuzzle::RiddlePuzzle(const std::string& riddleText, const std::string& ans
     : Puzzle(riddleText, "Think carefully...", 30, 10),
       riddle(riddleText),
       correctAnswer(answer),
-      riddleText(defaultFont),
-      inputText(defaultFont),
-      showFeedback(false) {
+      showFeedback(false),
+      answerInput(nullptr),
+      feedbackLabel(nullptr) {
     
     // Convert answer to lowercase for case-insensitive comparison
     std::transform(correctAnswer.begin(), correctAnswer.end(), correctAnswer.begin(), ::tolower);
@@ -43,95 +62,47 @@ bool RiddlePuzzle::solve(const std::string& answer) {
     lowerAnswer.erase(0, lowerAnswer.find_first_not_of(" \t\n\r"));
     lowerAnswer.erase(lowerAnswer.find_last_not_of(" \t\n\r") + 1);
     
-    if (lowerAnswer == correctAnswer) {
-        isSolved = true;
+    bool correct = lowerAnswer == correctAnswer;
+    if (correct) {
+        setSolved(true);
         feedbackMessage = "Correct! +" + std::to_string(timeBonus) + " seconds!";
-        showFeedback = true;
-        return true;
     } else {
         feedbackMessage = "Wrong! -" + std::to_string(timePenalty) + " seconds. Try again.";
-        showFeedback = true;
-        return false;
     }
+    showFeedback = true;
+    refreshScreen();
+    return correct;
+}
+
+// Static parts of the screen are created once; only the answer and the
+// feedback line change afterwards
+void RiddlePuzzle::buildScreen() {
+    screen.clear();
+    answerInput = nullptr;
+    feedbackLabel = nullptr;
+    if (!font) return;
+    
+    screen.addPanel({0.0f, 0.0f}, {800.0f, 600.0f}, sf::Color(0, 0, 0, 180));                  // Dark overlay
+    screen.addPanel({100.0f, 100.0f}, {600.0f, 400.0f}, sf::Color(40, 40, 60), 3.0f, sf::Color::White); // Puzzle box
+    screen.addLabel(*font, "RIDDLE PUZZLE", 28, sf::Color::Yellow, {250.0f, 120.0f});
+    screen.addLabel(*font, riddle, 20, sf::Color::White, {130.0f, 180.0f});
+    screen.addLabel(*font, "Your Answer:", 18, sf::Color::Cyan, {130.0f, 320.0f});
+    answerInput = &screen.addTextInput({130.0f, 350.0f}, {540.0f, 40.0f}, *font, 20, 30);
+    feedbackLabel = &screen.addLabel(*font, "", 18, sf::Color::Red, {130.0f, 410.0f});
+    screen.addLabel(*font, "Press ENTER to submit | ESC to exit", 16, sf::Color(150, 150, 150), {200.0f, 460.0f});
+    refreshScreen();
+}
+
+void RiddlePuzzle::refreshScreen() {
+    if (!answerInput) return;
+    answerInput->setValue(userAnswer);
+    feedbackLabel->setString(showFeedback ? feedbackMessage : std::string());
+    feedbackLabel->setFillColor(isSolved ? sf::Color::Green : sf::Color::Red);
 }
 
 void RiddlePuzzle::display(sf::RenderWindow& window) {
-    // Dark overlay
-    sf::RectangleShape overlay({800.0f, 600.0f});
-    overlay.setFillColor(sf::Color(0, 0, 0, 180));
-    window.draw(overlay);
-    
-    // Puzzle box
-    sf::RectangleShape puzzleBox({600.0f, 400.0f});
-    puzzleBox.setPosition({100.0f, 100.0f});
-    puzzleBox.setFillColor(sf::Color(40, 40, 60));
-    puzzleBox.setOutlineThickness(3.0f);
-    puzzleBox.setOutlineColor(sf::Color::White);
-    window.draw(puzzleBox);
-    
-    // Title
-    sf::Text title(font);
-    title.setString("RIDDLE PUZZLE");
-    title.setCharacterSize(28);
-    title.setFillColor(sf::Color::Yellow);
-    title.setPosition({250.0f, 120.0f});
-    window.draw(title);
-    
-    // Riddle text
-    riddleText.setFont(font);
-    riddleText.setString(riddle);
-    riddleText.setCharacterSize(20);
-    riddleText.setFillColor(sf::Color::White);
-    riddleText.setPosition({130.0f, 180.0f});
-    window.draw(riddleText);
-    
-    // Input prompt
-    sf::Text promptText(font);
-    promptText.setString("Your Answer:");
-    promptText.setCharacterSize(18);
-    promptText.setFillColor(sf::Color::Cyan);
-    promptText.setPosition({130.0f, 320.0f});
-    window.draw(promptText);
-    
-    // Input box
-    sf::RectangleShape inputBox({540.0f, 40.0f});
-    inputBox.setPosition({130.0f, 350.0f});
-    inputBox.setFillColor(sf::Color(20, 20, 30));
-    inputBox.setOutlineThickness(2.0f);
-    inputBox.setOutlineColor(sf::Color::White);
-    window.draw(inputBox);
-    
-    // User input text
-    inputText.setFont(font);
-    inputText.setString(userAnswer + "_");  // Cursor
-    inputText.setCharacterSize(20);
-    inputText.setFillColor(sf::Color::White);
-    inputText.setPosition({140.0f, 357.0f});
-    window.draw(inputText);
-    
-    // Feedback message
-    if (showFeedback) {
-        sf::Text feedback(font);
-        feedback.setString(feedbackMessage);
-        feedback.setCharacterSize(18);
-        
-        if (isSolved) {
-            feedback.setFillColor(sf::Color::Green);
-        } else {
-            feedback.setFillColor(sf::Color::Red);
-        }
-        
-        feedback.setPosition({130.0f, 410.0f});
-        window.draw(feedback);
-    }
-    
-    // Instructions
-    sf::Text instructions(font);
-    instructions.setString("Press ENTER to submit | ESC to exit");
-    instructions.setCharacterSize(16);
-    instructions.setFillColor(sf::Color(150, 150, 150));
-    instructions.setPosition({200.0f, 460.0f});
-    window.draw(instructions);
+    PROFILE_SCOPE("RiddlePuzzle::display");
+    window.draw(screen);
 }
 
 void RiddlePuzzle::handleInput(sf::Event& event) {
@@ -150,6 +121,7 @@ void RiddlePuzzle::handleInput(sf::Event& event) {
             userAnswer += entered;
             showFeedback = false;
         }
+        refreshScreen();
     }
     
     // Handle Enter key to submit
@@ -164,24 +136,45 @@ void RiddlePuzzle::update(float deltaTime) {
     // Animation or timer logic could go here
 }
 
-void RiddlePuzzle::setFont(const sf::Font& f) {
+void RiddlePuzzle::setFont(FontHandle f) {
     font = f;
-    riddleText.setFont(font);
-    inputText.setFont(font);
+    buildScreen();
 }
 
 // ============================================================================
 // PatternPuzzle - Click switches in correct order
 // ============================================================================
 
+namespace {
+    const char* const SWITCH_NAMES[] = {"Blue", "Red", "Green", "Yellow"};
+}
+
 PatternPuzzle::PatternPuzzle(const std::vector<int>& pattern)
     : Puzzle("Match the pattern", "Watch carefully...", 40, 15),
       correctPattern(pattern),
-      instructionText(defaultFont),
-      maxSwitches(pattern.size()) {
+      maxSwitches(pattern.size()),
+      sequenceLabel(nullptr) {}
+
+bool PatternPuzzle::solve(const std::string& answer) {
+    return checkPattern();
+}
+
+void PatternPuzzle::buildScreen() {
+    screen.clear();
+    sequenceLabel = nullptr;
+    if (!font) return;
+    
+    screen.addPanel({0.0f, 0.0f}, {800.0f, 600.0f}, sf::Color(0, 0, 0, 180));                  // Dark overlay
+    screen.addPanel({100.0f, 75.0f}, {600.0f, 450.0f}, sf::Color(40, 40, 60), 3.0f, sf::Color::White); // Puzzle box
+    screen.addLabel(*font, "PATTERN PUZZLE", 28, sf::Color::Yellow, {250.0f, 95.0f});
+    screen.addLabel(*font, "Click the switches in this order:\nBlue -> Green -> Red -> Yellow", 20,
+                    sf::Color::White, {150.0f, 150.0f});
+    sequenceLabel = &screen.addLabel(*font, "", 18, sf::Color::Cyan, {150.0f, 240.0f});
+    screen.addLabel(*font, "Click buttons in order | Press R to reset | ESC to exit", 16,
+                    sf::Color(150, 150, 150), {180.0f, 480.0f});
     
     // Create 4 colored switches
-    std::vector<sf::Color> colors = {
+    const sf::Color colors[] = {
         sf::Color::Blue,   // 1
         sf::Color::Red,    // 2
         sf::Color::Green,  // 3
@@ -193,75 +186,25 @@ PatternPuzzle::PatternPuzzle(const std::vector<int>& pattern)
     float y = 350.0f;
     
     for (int i = 0; i < 4; i++) {
-        sf::RectangleShape button({80.0f, 80.0f});
-        button.setPosition({startX + i * spacing, y});
-        button.setFillColor(colors[i]);
-        button.setOutlineThickness(3.0f);
-        button.setOutlineColor(sf::Color::White);
-        switches.push_back(button);
+        Button& button = screen.addButton(i + 1, {startX + i * spacing, y}, {80.0f, 80.0f}, colors[i], *font, "", 20);
+        button.getPanel().setOutline(3.0f, sf::Color::White);
     }
+    refreshScreen();
 }
 
-bool PatternPuzzle::solve(const std::string& answer) {
-    return checkPattern();
-}
-
-void PatternPuzzle::display(sf::RenderWindow& window) {
-    // Dark overlay
-    sf::RectangleShape overlay({800.0f, 600.0f});
-    overlay.setFillColor(sf::Color(0, 0, 0, 180));
-    window.draw(overlay);
-    
-    // Puzzle box
-    sf::RectangleShape puzzleBox({600.0f, 450.0f});
-    puzzleBox.setPosition({100.0f, 75.0f});
-    puzzleBox.setFillColor(sf::Color(40, 40, 60));
-    puzzleBox.setOutlineThickness(3.0f);
-    puzzleBox.setOutlineColor(sf::Color::White);
-    window.draw(puzzleBox);
-    
-    // Title
-    sf::Text title(font);
-    title.setString("PATTERN PUZZLE");
-    title.setCharacterSize(28);
-    title.setFillColor(sf::Color::Yellow);
-    title.setPosition({250.0f, 95.0f});
-    window.draw(title);
-    
-    // Instructions
-    sf::Text instructions(font);
-    instructions.setString("Click the switches in this order:\nBlue -> Green -> Red -> Yellow");
-    instructions.setCharacterSize(20);
-    instructions.setFillColor(sf::Color::White);
-    instructions.setPosition({150.0f, 150.0f});
-    window.draw(instructions);
-    
-    // Your sequence
-    sf::Text sequenceText(font);
+void PatternPuzzle::refreshScreen() {
+    if (!sequenceLabel) return;
     std::string seq = "Your sequence: ";
     for (size_t i = 0; i < playerPattern.size(); i++) {
-        std::vector<std::string> names = {"Blue", "Red", "Green", "Yellow"};
         if (i > 0) seq += " -> ";
-        seq += names[playerPattern[i] - 1];
+        seq += SWITCH_NAMES[playerPattern[i] - 1];
     }
-    sequenceText.setString(seq);
-    sequenceText.setCharacterSize(18);
-    sequenceText.setFillColor(sf::Color::Cyan);
-    sequenceText.setPosition({150.0f, 240.0f});
-    window.draw(sequenceText);
-    
-    // Draw switches
-    for (auto& sw : switches) {
-        window.draw(sw);
-    }
-    
-    // Instructions
-    sf::Text controls(font);
-    controls.setString("Click buttons in order | Press R to reset | ESC to exit");
-    controls.setCharacterSize(16);
-    controls.setFillColor(sf::Color(150, 150, 150));
-    controls.setPosition({180.0f, 480.0f});
-    window.draw(controls);
+    sequenceLabel->setString(seq);
+}
+
+void PatternPuzzle::display(sf::RenderWindow& window) {
+    PROFILE_SCOPE("PatternPuzzle::display");
+    window.draw(screen);
 }
 
 void PatternPuzzle::handleInput(sf::Event& event) {
@@ -272,23 +215,20 @@ void PatternPuzzle::handleInput(sf::Event& event) {
         if (mousePressed->button == sf::Mouse::Button::Left) {
             sf::Vector2f mousePos(mousePressed->position.x, mousePressed->position.y);
             
-            // Check which switch was clicked
-            for (size_t i = 0; i < switches.size(); i++) {
-                if (switches[i].getGlobalBounds().contains(mousePos)) {
-                    // Add to player pattern (1-indexed)
-                    playerPattern.push_back(i + 1);
-                    
-                    // Check if pattern is complete
-                    if (playerPattern.size() >= correctPattern.size()) {
-                        if (checkPattern()) {
-                            isSolved = true;
-                        } else {
-                            // Wrong! Auto-reset after a moment
-                            playerPattern.clear();
-                        }
+            // Check which switch was clicked (button id is the 1-indexed switch)
+            if (const Button* clicked = screen.buttonAt(mousePos)) {
+                playerPattern.push_back(clicked->getId());
+                
+                // Check if pattern is complete
+                if (playerPattern.size() >= correctPattern.size()) {
+                    if (checkPattern()) {
+                        setSolved(true);
+                    } else {
+                        // Wrong! Auto-reset after a moment
+                        playerPattern.clear();
                     }
-                    break;
                 }
+                refreshScreen();
             }
         }
     }
@@ -305,9 +245,9 @@ void PatternPuzzle::update(float deltaTime) {
     // Could add animations here
 }
 
-void PatternPuzzle::setFont(const sf::Font& f) {
+void PatternPuzzle::setFont(FontHandle f) {
     font = f;
-    instructionText.setFont(font);
+    buildScreen();
 }
 
 bool PatternPuzzle::checkPattern() {
@@ -326,6 +266,7 @@ bool PatternPuzzle::checkPattern() {
 
 void PatternPuzzle::resetPattern() {
     playerPattern.clear();
+    refreshScreen();
 }
 
 
@@ -333,228 +274,103 @@ void PatternPuzzle::resetPattern() {
 // LockPuzzle - Fully Interactive Numeric Keypad
 // ============================================================================
 
+namespace {
+    // Keypad layout (digit buttons use the digit itself as id)
+    const float KEYPAD_START_X = 235.0f;
+    const float KEYPAD_START_Y = 200.0f;
+    const float KEYPAD_BUTTON_SIZE = 65.0f;
+    const float KEYPAD_SPACING = 85.0f;
+    const int CLEAR_BUTTON_ID = 10;
+    const int ENTER_BUTTON_ID = 11;
+}
+
 LockPuzzle::LockPuzzle(const std::string& code)
     : Puzzle("Enter the code", "Look for clues...", 35, 10),
       correctCode(code),
-      codeDisplay(defaultFont),
-      instructionText(defaultFont),
-      maxDigits(code.length()) {}
+      maxDigits(code.length()),
+      codeLabel(nullptr),
+      feedbackLabel(nullptr) {}
 
 bool LockPuzzle::solve(const std::string& answer) {
     if (enteredCode == correctCode) {
-        isSolved = true;
+        setSolved(true);
+        refreshScreen();
         return true;
     }
     return false;
 }
 
-void LockPuzzle::display(sf::RenderWindow& window) {
-    // Dark overlay
-    sf::RectangleShape overlay({800.0f, 600.0f});
-    overlay.setFillColor(sf::Color(0, 0, 0, 180));
-    window.draw(overlay);
-    
-    // Puzzle box - SMALLER to fit everything
-    sf::RectangleShape puzzleBox({550.0f, 550.0f});
-    puzzleBox.setPosition({125.0f, 25.0f});
-    puzzleBox.setFillColor(sf::Color(40, 40, 60));
-    puzzleBox.setOutlineThickness(3.0f);
-    puzzleBox.setOutlineColor(sf::Color::White);
-    window.draw(puzzleBox);
-    
-    // Title
-    sf::Text title(font);
-    title.setString("LOCK PUZZLE");
-    title.setCharacterSize(26);
-    title.setFillColor(sf::Color::Yellow);
-    title.setPosition({310.0f, 40.0f});
-    window.draw(title);
-    
-    // Instructions
-    sf::Text instructions(font);
-    instructions.setString("Enter the 4-digit code:");
-    instructions.setCharacterSize(18);
-    instructions.setFillColor(sf::Color::White);
-    instructions.setPosition({280.0f, 80.0f});
-    window.draw(instructions);
-    
-    // Code display box
-    sf::RectangleShape displayBox({300.0f, 50.0f});
-    displayBox.setPosition({250.0f, 115.0f});
-    displayBox.setFillColor(sf::Color(20, 20, 30));
-    displayBox.setOutlineThickness(3.0f);
-    displayBox.setOutlineColor(sf::Color::Cyan);
-    window.draw(displayBox);
-    
-    // Display entered code
-    std::string displayCode = "";
-    for (size_t i = 0; i < enteredCode.length(); i++) {
-        displayCode += enteredCode[i];
-        displayCode += " ";
-    }
-    
-    // Add underscores for remaining digits
-    for (size_t i = enteredCode.length(); i < (size_t)maxDigits; i++) {
-        displayCode += "_ ";
-    }
+void LockPuzzle::buildScreen() {
+    screen.clear();
+    codeLabel = nullptr;
+    feedbackLabel = nullptr;
+    if (!font) return;
     
-    codeDisplay.setFont(font);
-    codeDisplay.setString(displayCode);
-    codeDisplay.setCharacterSize(32);
-    codeDisplay.setFillColor(sf::Color::White);
-    codeDisplay.setPosition({290.0f, 125.0f});
-    window.draw(codeDisplay);
+    screen.addPanel({0.0f, 0.0f}, {800.0f, 600.0f}, sf::Color(0, 0, 0, 180));                  // Dark overlay
+    screen.addPanel({125.0f, 25.0f}, {550.0f, 550.0f}, sf::Color(40, 40, 60), 3.0f, sf::Color::White); // Puzzle box
+    screen.addLabel(*font, "LOCK PUZZLE", 26, sf::Color::Yellow, {310.0f, 40.0f});
+    screen.addLabel(*font, "Enter the 4-digit code:", 18, sf::Color::White, {280.0f, 80.0f});
+    screen.addPanel({250.0f, 115.0f}, {300.0f, 50.0f}, sf::Color(20, 20, 30), 3.0f, sf::Color::Cyan); // Code display box
+    codeLabel = &screen.addLabel(*font, "", 32, sf::Color::White, {290.0f, 125.0f});
     
-    // Draw numeric keypad - ADJUSTED POSITIONS AND SMALLER BUTTONS
-    float keypadStartX = 235.0f;
-    float keypadStartY = 200.0f;
-    float buttonSize = 65.0f;  // Smaller buttons
-    float spacing = 85.0f;     // Tighter spacing
+    sf::Vector2f buttonSize(KEYPAD_BUTTON_SIZE, KEYPAD_BUTTON_SIZE);
     
     // Buttons 1-9
     for (int i = 1; i <= 9; i++) {
         int row = (i - 1) / 3;
         int col = (i - 1) % 3;
-        
-        float x = keypadStartX + col * spacing;
-        float y = keypadStartY + row * spacing;
-        
-        // Button background
-        sf::RectangleShape button({buttonSize, buttonSize});
-        button.setPosition({x, y});
-        button.setFillColor(sf::Color(60, 60, 80));
-        button.setOutlineThickness(2.0f);
-        button.setOutlineColor(sf::Color::White);
-        window.draw(button);
-        
-        // Button number
-        sf::Text buttonText(font);
-        buttonText.setString(std::to_string(i));
-        buttonText.setCharacterSize(28);
-        buttonText.setFillColor(sf::Color::White);
-        buttonText.setPosition({x + 23.0f, y + 15.0f});
-        window.draw(buttonText);
+        sf::Vector2f pos(KEYPAD_START_X + col * KEYPAD_SPACING, KEYPAD_START_Y + row * KEYPAD_SPACING);
+        screen.addButton(i, pos, buttonSize, sf::Color(60, 60, 80), *font, std::to_string(i), 28);
     }
     
     // Bottom row: Clear, 0, Enter
-    // Clear button
-    sf::RectangleShape clearButton({buttonSize, buttonSize});
-    clearButton.setPosition({keypadStartX, keypadStartY + 3 * spacing});
-    clearButton.setFillColor(sf::Color(100, 50, 50));
-    clearButton.setOutlineThickness(2.0f);
-    clearButton.setOutlineColor(sf::Color::White);
-    window.draw(clearButton);
-    
-    sf::Text clearText(font);
-    clearText.setString("C");
-    clearText.setCharacterSize(26);
-    clearText.setFillColor(sf::Color::White);
-    clearText.setPosition({keypadStartX + 23.0f, keypadStartY + 3 * spacing + 16.0f});
-    window.draw(clearText);
-    
-    // 0 button
-    sf::RectangleShape zeroButton({buttonSize, buttonSize});
-    zeroButton.setPosition({keypadStartX + spacing, keypadStartY + 3 * spacing});
-    zeroButton.setFillColor(sf::Color(60, 60, 80));
-    zeroButton.setOutlineThickness(2.0f);
-    zeroButton.setOutlineColor(sf::Color::White);
-    window.draw(zeroButton);
-    
-    sf::Text zeroText(font);
-    zeroText.setString("0");
-    zeroText.setCharacterSize(28);
-    zeroText.setFillColor(sf::Color::White);
-    zeroText.setPosition({keypadStartX + spacing + 23.0f, keypadStartY + 3 * spacing + 15.0f});
-    window.draw(zeroText);
-    
-    // OK button
-    sf::RectangleShape enterButton({buttonSize, buttonSize});
-    enterButton.setPosition({keypadStartX + 2 * spacing, keypadStartY + 3 * spacing});
-    enterButton.setFillColor(sf::Color(50, 100, 50));
-    enterButton.setOutlineThickness(2.0f);
-    enterButton.setOutlineColor(sf::Color::White);
-    window.draw(enterButton);
-    
-    sf::Text enterText(font);
-    enterText.setString("OK");
-    enterText.setCharacterSize(22);
-    enterText.setFillColor(sf::Color::White);
-    enterText.setPosition({keypadStartX + 2 * spacing + 15.0f, keypadStartY + 3 * spacing + 18.0f});
-    window.draw(enterText);
+    float bottomY = KEYPAD_START_Y + 3 * KEYPAD_SPACING;
+    screen.addButton(CLEAR_BUTTON_ID, {KEYPAD_START_X, bottomY}, buttonSize, sf::Color(100, 50, 50), *font, "C", 26);
+    screen.addButton(0, {KEYPAD_START_X + KEYPAD_SPACING, bottomY}, buttonSize, sf::Color(60, 60, 80), *font, "0", 28);
+    screen.addButton(ENTER_BUTTON_ID, {KEYPAD_START_X + 2 * KEYPAD_SPACING, bottomY}, buttonSize,
+                     sf::Color(50, 100, 50), *font, "OK", 22);
+    
+    feedbackLabel = &screen.addLabel(*font, "", 20, sf::Color::Green, {235.0f, 510.0f});
+    screen.addLabel(*font, "Click keypad or use keyboard | ESC to exit", 15, sf::Color(150, 150, 150), {220.0f, 545.0f});
+    refreshScreen();
+}
+
+void LockPuzzle::refreshScreen() {
+    if (!codeLabel) return;
     
-    // Feedback message
-    if (isSolved) {
-        sf::Text feedback(font);
-        feedback.setString("Correct! +" + std::to_string(timeBonus) + " seconds!");
-        feedback.setCharacterSize(20);
-        feedback.setFillColor(sf::Color::Green);
-        feedback.setPosition({235.0f, 510.0f});
-        window.draw(feedback);
+    // Entered digits followed by underscores for the remaining ones
+    std::string displayCode;
+    for (size_t i = 0; i < enteredCode.length(); i++) {
+        displayCode += enteredCode[i];
+        displayCode += ' ';
     }
+    for (size_t i = enteredCode.length(); i < (size_t)maxDigits; i++) {
+        displayCode += "_ ";
+    }
+    codeLabel->setString(displayCode);
     
-    // Instructions at bottom
-    sf::Text controls(font);
-    controls.setString("Click keypad or use keyboard | ESC to exit");
-    controls.setCharacterSize(15);
-    controls.setFillColor(sf::Color(150, 150, 150));
-    controls.setPosition({220.0f, 545.0f});
-    window.draw(controls);
+    if (isSolved) feedbackLabel->setString("Correct! +" + std::to_string(timeBonus) + " seconds!");
+    else feedbackLabel->setString(std::string());
 }
+
+void LockPuzzle::display(sf::RenderWindow& window) {
+    PROFILE_SCOPE("LockPuzzle::display");
+    window.draw(screen);
+}
+
 void LockPuzzle::handleInput(sf::Event& event) {
     if (isSolved) return;  // Don't accept input if already solved
     
-    // Handle mouse clicks on keypad - UPDATED POSITIONS
+    // Handle mouse clicks on keypad
     if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
         if (mousePressed->button == sf::Mouse::Button::Left) {
-            float mouseX = static_cast<float>(mousePressed->position.x);
-            float mouseY = static_cast<float>(mousePressed->position.y);
+            sf::Vector2f mousePos(static_cast<float>(mousePressed->position.x),
+                                  static_cast<float>(mousePressed->position.y));
             
-            // UPDATED to match display() positions
-            float keypadStartX = 235.0f;
-            float keypadStartY = 200.0f;
-            float buttonSize = 65.0f;
-            float spacing = 85.0f;
-            
-            // Check buttons 1-9
-            for (int i = 1; i <= 9; i++) {
-                int row = (i - 1) / 3;
-                int col = (i - 1) % 3;
-                
-                float x = keypadStartX + col * spacing;
-                float y = keypadStartY + row * spacing;
-                
-                if (mouseX >= x && mouseX <= x + buttonSize &&
-                    mouseY >= y && mouseY <= y + buttonSize) {
-                    addDigit('0' + i);
-                    return;
-                }
-            }
-            
-            // Check Clear button (bottom left)
-            float clearX = keypadStartX;
-            float clearY = keypadStartY + 3 * spacing;
-            if (mouseX >= clearX && mouseX <= clearX + buttonSize &&
-                mouseY >= clearY && mouseY <= clearY + buttonSize) {
-                clearCode();
-                return;
-            }
-            
-            // Check 0 button (bottom middle)
-            float zeroX = keypadStartX + spacing;
-            float zeroY = keypadStartY + 3 * spacing;
-            if (mouseX >= zeroX && mouseX <= zeroX + buttonSize &&
-                mouseY >= zeroY && mouseY <= zeroY + buttonSize) {
-                addDigit('0');
-                return;
-            }
-            
-            // Check OK button (bottom right)
-            float enterX = keypadStartX + 2 * spacing;
-            float enterY = keypadStartY + 3 * spacing;
-            if (mouseX >= enterX && mouseX <= enterX + buttonSize &&
-                mouseY >= enterY && mouseY <= enterY + buttonSize) {
-                solve(enteredCode);
-                return;
+            if (const Button* clicked = screen.buttonAt(mousePos)) {
+                if (clicked->getId() == CLEAR_BUTTON_ID) clearCode();
+                else if (clicked->getId() == ENTER_BUTTON_ID) solve(enteredCode);
+                else addDigit(static_cast<char>('0' + clicked->getId()));
             }
         }
     }
@@ -585,24 +401,26 @@ void LockPuzzle::update(float deltaTime) {
     // Animation or timer logic could go here
 }
 
-void LockPuzzle::setFont(const sf::Font& f) {
+void LockPuzzle::setFont(FontHandle f) {
     font = f;
-    codeDisplay.setFont(font);
-    instructionText.setFont(font);
+    buildScreen();
 }
 
 void LockPuzzle::addDigit(char digit) {
     if (enteredCode.length() < (size_t)maxDigits && digit >= '0' && digit <= '9') {
         enteredCode += digit;
+        refreshScreen();
     }
 }
 
 void LockPuzzle::removeDigit() {
     if (!enteredCode.empty()) {
         enteredCode.pop_back();
+        refreshScreen();
     }
 }
 
 void LockPuzzle::clearCode() {
     enteredCode.clear();
-}
\ No newline at end of file
+    refreshScreen();
+}
@@ -2,7 +2,14 @@
 #define PUZZLE_H
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
+#include <vector>
+#include "ResourceCache.h"
+#include "Widgets.h"
+
+class Room;
+class Item;
 
 // Abstract base class for all puzzles
 class Puzzle {
@@ -13,6 +20,13 @@ protected:
     int timeBonus; // Time bonus for solving
     int timePenalty; // Time penalty for failing
     
+    // Owning room: keeps its solved counters and provides the event bus
+    Room* owner;
+    
+    // Level data: shown when the puzzle is opened / placed in the room once solved
+    std::string prompt;
+    std::vector<std::shared_ptr<Item>> rewards;
+    
 public:
     // Constructor
     Puzzle(const std::string& desc, const std::string& hintText, int bonus = 30, int penalty = 10);
@@ -26,13 +40,26 @@ public:
     virtual void handleInput(sf::Event& event) = 0;
     virtual void update(float deltaTime) = 0;
     
+    // Screens are only built once a font arrives; headless runs never send one
+    virtual void setFont(FontHandle /*font*/) {}
+    
     // Common functions
     bool isSolvedStatus() const;
     std::string getDescription() const;
     std::string getHint() const;
     int getTimeBonus() const;
     int getTimePenalty() const;
+    // Every flip updates the room's counters; unsolved -> solved also
+    // publishes PUZZLE_SOLVED. Derived puzzles must go through here.
     void setSolved(bool status);
+    
+    void setOwner(Room* room);
+    int getRoomID() const;
+    
+    void setPrompt(const std::string& text);
+    const std::string& getPrompt() const;
+    void addReward(std::shared_ptr<Item> item);
+    const std::vector<std::shared_ptr<Item>>& getRewards() const;
 };
 
 // Riddle Puzzle - Answer a logic riddle
@@ -41,13 +68,18 @@ private:
     std::string riddle;
     std::string correctAnswer;
     std::string userAnswer;
-    sf::Font defaultFont;
-    sf::Font font;
-    sf::Text riddleText;
-    sf::Text inputText;
+    FontHandle font; // Shared from the ResourceCache
     bool showFeedback;
     std::string feedbackMessage;
     
+    // Retained screen, built once the font is known
+    UiScreen screen;
+    TextInput* answerInput;
+    Label* feedbackLabel;
+    
+    void buildScreen();
+    void refreshScreen();
+    
 public:
     RiddlePuzzle(const std::string& riddleText, const std::string& answer);
     
@@ -56,7 +88,7 @@ public:
     void handleInput(sf::Event& event) override;
     void update(float deltaTime) override;
     
-    void setFont(const sf::Font& f);
+    void setFont(FontHandle f) override;
 };
 
 // Pattern Puzzle - Replicate a pattern using switches
@@ -64,12 +96,16 @@ class PatternPuzzle : public Puzzle {
 private:
     std::vector<int> correctPattern; // e.g., {1, 3, 2, 4}
     std::vector<int> playerPattern;
-    std::vector<sf::RectangleShape> switches;
-    sf::Font defaultFont;
-    sf::Font font;
-    sf::Text instructionText;
+    FontHandle font; // Shared from the ResourceCache
     int maxSwitches;
     
+    // Retained screen; the switches are its buttons (ids 1-4)
+    UiScreen screen;
+    Label* sequenceLabel;
+    
+    void buildScreen();
+    void refreshScreen();
+    
 public:
     PatternPuzzle(const std::vector<int>& pattern);
     
@@ -78,7 +114,7 @@ public:
     void handleInput(sf::Event& event) override;
     void update(float deltaTime) override;
     
-    void setFont(const sf::Font& f);
+    void setFont(FontHandle f) override;
     bool checkPattern();
     void resetPattern();
 };
@@ -88,12 +124,17 @@ class LockPuzzle : public Puzzle {
 private:
     std::string correctCode;
     std::string enteredCode;
-    sf::Font defaultFont;
-    sf::Font font;
-    sf::Text codeDisplay;
-    sf::Text instructionText;
+    FontHandle font; // Shared from the ResourceCache
     int maxDigits;
     
+    // Retained screen; keypad buttons use the digit as id
+    UiScreen screen;
+    Label* codeLabel;
+    Label* feedbackLabel;
+    
+    void buildScreen();
+    void refreshScreen();
+    
 public:
     LockPuzzle(const std::string& code);
     
@@ -102,7 +143,7 @@ public:
     void handleInput(sf::Event& event) override;
     void update(float deltaTime) override;
     
-    void setFont(const sf::Font& f);
+    void setFont(FontHandle f) override;
     void addDigit(char digit);
     void removeDigit();
     void clearCode();
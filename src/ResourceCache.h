@@ -0,0 +1,90 @@
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Shared, read-only handles borrowed by every subsystem
+using FontHandle = std::shared_ptr<const sf::Font>;
+using TextureHandle = std::shared_ptr<const sf::Texture>;
+using SoundBufferHandle = std::shared_ptr<const sf::SoundBuffer>;
+
+// Default loaders used by ResourceCache::load
+inline bool loadResource(sf::Font& font, const std::string& path) { return font.openFromFile(path); }
+inline bool loadResource(sf::Texture& texture, const std::string& path) { return texture.loadFromFile(path); }
+inline bool loadResource(sf::SoundBuffer& buffer, const std::string& path) { return buffer.loadFromFile(path); }
+
+// Empty font for sf::Text members that need one before the real font arrives.
+// Never drawn with; shared so no class has to carry its own sf::Font.
+inline const sf::Font& placeholderFont() {
+    static const sf::Font font;
+    return font;
+}
+
+// ResourceCache - Loads each resource once and hands out reference-counted
+// handles. The cache only keeps weak references, so a resource is freed as
+// soon as the last subsystem borrowing it lets go.
+template <typename T>
+class ResourceCache {
+public:
+    using Handle = std::shared_ptr<T>;
+    using Loader = std::function<bool(T&)>;
+
+private:
+    std::unordered_map<std::string, std::weak_ptr<T>> entries;
+
+public:
+    // Return the live resource for key, or create it with loader.
+    // Returns nullptr if the loader fails.
+    Handle acquire(const std::string& key, const Loader& loader) {
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            if (Handle existing = it->second.lock()) return existing;
+        }
+        auto resource = std::make_shared<T>();
+        if (!loader(*resource)) return nullptr;
+        entries[key] = resource;
+        return resource;
+    }
+
+    // Load from a file path, which doubles as the key
+    Handle load(const std::string& path) {
+        return acquire(path, [&path](T& resource) { return loadResource(resource, path); });
+    }
+
+    // Look up without loading
+    Handle find(const std::string& key) const {
+        auto it = entries.find(key);
+        return it != entries.end() ? it->second.lock() : nullptr;
+    }
+
+    // Number of resources currently alive
+    std::size_t getLiveCount() const {
+        std::size_t count = 0;
+        for (const auto& entry : entries) {
+            if (!entry.second.expired()) count++;
+        }
+        return count;
+    }
+
+    // Forget entries whose resource has already been freed
+    void prune() {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second.expired()) it = entries.erase(it);
+            else ++it;
+        }
+    }
+};
+
+// Resources - One cache per resource type, owned by Game
+struct Resources {
+    ResourceCache<sf::Font> fonts;
+    ResourceCache<sf::Texture> textures;
+    ResourceCache<sf::SoundBuffer> sounds;
+};
+
+#endif // RESOURCE_CACHE_H
@@ -8,7 +8,23 @@
 #include "Puzzle.h"
 #include "Item.h"
 #include "Guard.h"
+#include "SpriteBatch.h"
+#include "EventBus.h"
+#include "Profiler.h"
+#include "AssetCooker.h"
 #include <iostream>
+#include <algorithm>
+
+// Grid cell edge for the room's spatial indexes: about one character wide
+// plus margin, so most queries touch one to four cells
+static const float INDEX_CELL_SIZE = 64.0f;
+
+// Shown while a background is still streaming in, or failed to load
+static const sf::Color BACKDROP_COLOR(40, 40, 50);
+
+// Obstacles are drawn as display cases
+static const sf::Color OBSTACLE_FILL(90, 70, 50);
+static const sf::Color OBSTACLE_OUTLINE(200, 180, 140);
 
 // Constructor
 Room::Room(int id, const std::string& name, float x, float y, float width, float height, const std::string& imagePath)
@@ -16,69 +32,246 @@ Room::Room(int id, const std::string& name, float x, float y, float width, float
       roomName(name),
       position(x, y),
       size(width, height),
-      bgSprite(bgTexture), // Initialize sprite with texture
+      backgroundPath(imagePath),
+      activeFlow(0),
+      flowJob(FlowFieldWorker::NO_JOB),
+      alarmTimer(0.0f),
+      intruder(0.0f, 0.0f),
+      sighting(0.0f, 0.0f),
+      maxDetectionRadius(0.0f),
       isExitRoom(false),
-      isVisited(false)
+      isVisited(false),
+      events(nullptr),
+      worldProgress(nullptr)
 {
-    // Attempt to load background texture
-    if (!bgTexture.loadFromFile(imagePath)) {
-        // Fallback: Create a colored background if image fails
-        sf::Image img;
-        // SFML 3.0 uses resize() instead of create()
-        img.resize({static_cast<unsigned int>(width), static_cast<unsigned int>(height)}, sf::Color(40, 40, 50));
-        
-        if (!bgTexture.loadFromImage(img)) {
-             std::cerr << "Error: Failed to create fallback texture." << std::endl;
-        }
-        std::cout << "Warning: Could not load " << imagePath << ". Using default color." << std::endl;
-    }
+    guardIndex.reset(getBounds(), INDEX_CELL_SIZE);
+    itemIndex.reset(getBounds(), INDEX_CELL_SIZE);
+    doorIndex.reset(getBounds(), INDEX_CELL_SIZE);
     
-    // --- CRITICAL FIX START ---
-    // We must tell the sprite the new size of the texture, otherwise it draws nothing!
-    sf::Vector2u texSize = bgTexture.getSize();
-    bgSprite.setTextureRect(sf::IntRect({0, 0}, {static_cast<int>(texSize.x), static_cast<int>(texSize.y)}));
-    // --- CRITICAL FIX END ---
+    // The background image is streamed in separately (RoomStreamer) so rooms
+    // can be built without touching the disk, on any thread, or headless
+    backdrop.setPosition(position);
+    backdrop.setSize(size);
+    backdrop.setFillColor(BACKDROP_COLOR);
+    
+    // Guards route their legs through the room's grid and look across
+    // the sight grid (both all open for now)
+    navGrid.build(getBounds(), obstacles, CHARACTER_DISPLAY_SIZE);
+    sightGrid.build(getBounds(), obstacles, {0.0f, 0.0f});
+    pathService.setGrid(&navGrid);
+    guardSystem.setNavigation(&pathService);
+    guardSystem.setOccluders(&sightGrid, CHARACTER_DISPLAY_SIZE / 2.0f);
+}
+
+Room::~Room() {
+    FlowFieldWorker::global().wait(flowJob);
+}
+
+// The texture is stretched to fit the room exactly
+void Room::setBackground(std::shared_ptr<const sf::Texture> texture) {
+    background = texture;
+    backdrop.setTexture(background.get(), true);
+    backdrop.setFillColor(background ? sf::Color::White : BACKDROP_COLOR);
+}
+
+bool Room::hasBackground() const { return background != nullptr; }
+const std::string& Room::getBackgroundPath() const { return backgroundPath; }
+
+void Room::setEventBus(EventBus* bus) {
+    events = bus;
+    for (auto& door : doors) door->setEventBus(events, roomID);
+}
+
+EventBus* Room::getEventBus() const { return events; }
 
-    bgSprite.setPosition(position);
+void Room::addPuzzle(std::shared_ptr<Puzzle> puzzle) {
+    puzzle->setOwner(this);
+    puzzles.push_back(puzzle);
     
-    // Scale sprite to fit room dimensions exactly
-    if (texSize.x > 0 && texSize.y > 0) {
-        bgSprite.setScale({width / texSize.x, height / texSize.y});
+    bool solved = puzzle->isSolvedStatus();
+    progress.total++;
+    if (solved) progress.solved++;
+    if (worldProgress) {
+        worldProgress->total++;
+        if (solved) worldProgress->solved++;
     }
 }
-
-void Room::addPuzzle(std::shared_ptr<Puzzle> puzzle) { puzzles.push_back(puzzle); }
 std::vector<std::shared_ptr<Puzzle>>& Room::getPuzzles() { return puzzles; }
 
-bool Room::allPuzzlesSolved() const {
-    for (const auto& puzzle : puzzles) {
-        if (!puzzle->isSolvedStatus()) return false;
+bool Room::allPuzzlesSolved() const { return progress.allSolved(); }
+const PuzzleProgress& Room::getPuzzleProgress() const { return progress; }
+
+void Room::attachProgress(PuzzleProgress* world, bool countTotals) {
+    worldProgress = world;
+    if (worldProgress) {
+        if (countTotals) worldProgress->total += progress.total;
+        worldProgress->solved += progress.solved;
+    }
+}
+
+void Room::onPuzzleSolvedChanged(bool solved) {
+    if (solved) {
+        progress.solved++;
+        if (worldProgress) worldProgress->solved++;
+    } else {
+        progress.solved--;
+        if (worldProgress) worldProgress->solved--;
     }
-    return true;
 }
 
-void Room::addItem(std::shared_ptr<Item> item) { items.push_back(item); }
+void Room::addItem(std::shared_ptr<Item> item) {
+    items.push_back(item);
+    itemIndex.insert(item.get(), item->getBounds());
+    contentsChanged();
+}
 void Room::removeItem(std::shared_ptr<Item> item) {
     for (auto it = items.begin(); it != items.end(); ++it) {
         if (*it == item) {
+            itemIndex.remove(item.get(), item->getBounds());
             items.erase(it);
+            contentsChanged();
             return;
         }
     }
 }
+void Room::collectItem(Item& item) {
+    item.collect();
+    contentsChanged();
+}
 std::vector<std::shared_ptr<Item>>& Room::getItems() { return items; }
 
-void Room::addGuard(std::shared_ptr<Guard> guard) { guards.push_back(guard); }
+void Room::contentsChanged() {
+    if (events) events->publish(GameEvent::Type::ROOM_CONTENTS_CHANGED, NO_ITEM, roomID);
+}
+
+void Room::addObstacle(const sf::FloatRect& bounds) {
+    obstacles.push_back(bounds);
+    
+    sf::RectangleShape shape(bounds.size);
+    shape.setPosition(bounds.position);
+    shape.setFillColor(OBSTACLE_FILL);
+    shape.setOutlineThickness(2.0f);
+    shape.setOutlineColor(OBSTACLE_OUTLINE);
+    obstacleShapes.push_back(shape);
+    
+    // Rooms get a handful of obstacles while being built; a full rebuild
+    // of an 80x60 grid each time is cheaper than keeping it incremental.
+    // Flow fields built on the old grid are dropped.
+    FlowFieldWorker::global().wait(flowJob);
+    flowJob = FlowFieldWorker::NO_JOB;
+    flowFields[0] = FlowField();
+    flowFields[1] = FlowField();
+    navGrid.build(getBounds(), obstacles, CHARACTER_DISPLAY_SIZE);
+    sightGrid.build(getBounds(), obstacles, {0.0f, 0.0f});
+    pathService.setGrid(&navGrid);
+    guardSystem.setOccluders(&sightGrid, CHARACTER_DISPLAY_SIZE / 2.0f);
+    contentsChanged();
+}
+
+const std::vector<sf::FloatRect>& Room::getObstacles() const { return obstacles; }
+
+bool Room::isBlocked(const sf::FloatRect& bounds) const {
+    for (const sf::FloatRect& obstacle : obstacles) {
+        if (obstacle.findIntersection(bounds)) return true;
+    }
+    return false;
+}
+
+const NavGrid& Room::getNavGrid() const { return navGrid; }
+const NavGrid& Room::getSightGrid() const { return sightGrid; }
+PathService& Room::getPathService() { return pathService; }
+
+void Room::addGuard(std::shared_ptr<Guard> guard) {
+    guards.push_back(guard);
+    guard->joinSystem(guardSystem);
+    guard->setSpatialIndex(&guardIndex);
+    maxDetectionRadius = std::max(maxDetectionRadius, guard->getDetectionRadius());
+}
 std::vector<std::shared_ptr<Guard>>& Room::getGuards() { return guards; }
+GuardSystem& Room::getGuardSystem() { return guardSystem; }
+
+// ============================================================================
+// Alarm
+// ============================================================================
+
+void Room::raiseAlarm(float seconds) {
+    alarmTimer = std::max(alarmTimer, seconds);
+    sighting = intruder;
+    requestFlow(navGrid.nearestOpen(navGrid.cellAt(intruder)));
+}
+
+bool Room::isAlarmRaised() const { return alarmTimer > 0.0f; }
+
+// The field only changes when the intruder crosses into another cell
+void Room::trackIntruder(const sf::Vector2f& position) {
+    intruder = position;
+    if (alarmTimer > 0.0f) requestFlow(navGrid.nearestOpen(navGrid.cellAt(intruder)));
+}
+
+// At most one build in flight; a newer goal waits for the next tick
+void Room::requestFlow(int goalCell) {
+    if (goalCell < 0 || flowJob != FlowFieldWorker::NO_JOB) return;
+    if (flowFields[activeFlow].getGoal() == goalCell) return;
+    flowJob = FlowFieldWorker::global().submit(navGrid, goalCell, flowFields[1 - activeFlow]);
+}
+
+void Room::finishFlow() {
+    if (flowJob == FlowFieldWorker::NO_JOB) return;
+    FlowFieldWorker::global().wait(flowJob);
+    flowJob = FlowFieldWorker::NO_JOB;
+    activeFlow = 1 - activeFlow;
+}
+
+void Room::updateGuards(float deltaTime) {
+    PROFILE_SCOPE("Room::updateGuards");
+    if (alarmTimer > 0.0f) {
+        finishFlow();
+        alarmTimer -= deltaTime;
+        if (alarmTimer > 0.0f) {
+            // Queue the intruder's current cell for the next tick
+            requestFlow(navGrid.nearestOpen(navGrid.cellAt(intruder)));
+            if (flowFields[activeFlow].isBuilt()) guardSystem.converge(flowFields[activeFlow], intruder);
+        } else {
+            // Search where the intruder was seen, then resume the patrols
+            alarmTimer = 0.0f;
+            guardSystem.endConverge();
+            for (std::size_t slot = 0; slot < guardSystem.size(); slot++) guardSystem.investigate(slot, sighting);
+        }
+    }
+    pathService.update();
+    guardSystem.savePreviousPositions();
+    guardSystem.update(deltaTime);
+    
+    // The index only moves entries whose cell changed
+    for (auto& guard : guards) {
+        std::size_t slot = guard->getSlot();
+        guardIndex.update(guard.get(), sf::FloatRect(guardSystem.getPreviousPosition(slot), {0.0f, 0.0f}),
+                          sf::FloatRect(guardSystem.getPosition(slot), {0.0f, 0.0f}));
+    }
+}
+
+void Room::detectGuards(const sf::Vector2f& playerPosition, std::vector<std::size_t>& hits) {
+    findGuardsNear(playerPosition, maxDetectionRadius, nearbyGuards);
+    candidateSlots.clear();
+    for (Guard* guard : nearbyGuards) candidateSlots.push_back(guard->getSlot());
+    // Slot order: the same hits, in the same order, as testing every guard
+    std::sort(candidateSlots.begin(), candidateSlots.end());
+    guardSystem.detect(playerPosition, candidateSlots, hits);
+}
 
-void Room::addDoor(std::shared_ptr<Door> door) { doors.push_back(door); }
+void Room::addDoor(std::shared_ptr<Door> door) {
+    door->setEventBus(events, roomID);
+    doors.push_back(door);
+    doorIndex.insert(door.get(), door->getBounds());
+    contentsChanged();
+}
 std::vector<std::shared_ptr<Door>>& Room::getDoors() { return doors; }
 
 int Room::getRoomID() const { return roomID; }
 std::string Room::getRoomName() const { return roomName; }
 sf::Vector2f Room::getPosition() const { return position; }
 sf::Vector2f Room::getSize() const { return size; }
-sf::FloatRect Room::getBounds() const { return bgSprite.getGlobalBounds(); }
+sf::FloatRect Room::getBounds() const { return sf::FloatRect(position, size); }
 
 void Room::setExitRoom(bool isExit) { isExitRoom = isExit; }
 bool Room::isExit() const { return isExitRoom; }
@@ -91,21 +284,59 @@ void Room::update(float deltaTime) {
     }
 }
 
-void Room::draw(sf::RenderWindow& window) {
-    // Draw the background image
-    window.draw(bgSprite);
+void Room::draw(sf::RenderTarget& target, SpriteBatch& batch, bool showVisionCones) {
+    drawStatic(target, batch);
+    drawGuards(target, batch, showVisionCones);
+}
+
+void Room::drawStatic(sf::RenderTarget& target, SpriteBatch& batch) {
+    PROFILE_SCOPE("Room::drawStatic");
+    // Draw the background image (or its stand-in color)
+    target.draw(backdrop);
+    for (const auto& shape : obstacleShapes) target.draw(shape);
     
-    for (auto& guard : guards) guard->draw(window, true);
-    for (auto& door : doors) door->draw(window);
+    // Without an atlas there is nothing to batch against; draw one by one
+    if (!batch.getAtlas()) {
+        for (auto& door : doors) door->draw(target);
+        for (auto& item : items) {
+            if (!item->isItemCollected()) item->draw(target);
+        }
+        return;
+    }
+    
+    // Doors and items go into the caller's batch, submitted as one draw
+    for (auto& door : doors) door->draw(batch);
     for (auto& item : items) {
-        if (!item->isItemCollected()) item->draw(window);
+        if (!item->isItemCollected()) item->draw(batch);
+    }
+}
+
+void Room::drawGuards(sf::RenderTarget& target, SpriteBatch& batch, bool showVisionCones) {
+    if (!batch.getAtlas()) {
+        for (auto& guard : guards) guard->draw(target, showVisionCones);
+        return;
     }
+    for (auto& guard : guards) guard->draw(batch, showVisionCones);
 }
 
 bool Room::containsPoint(const sf::Vector2f& point) const {
-    return bgSprite.getGlobalBounds().contains(point);
+    return getBounds().contains(point);
 }
 
+void Room::findGuardsNear(const sf::Vector2f& point, float radius, std::vector<Guard*>& out) const {
+    guardIndex.query(sf::FloatRect({point.x - radius, point.y - radius}, {radius * 2.0f, radius * 2.0f}), out);
+}
+
+void Room::findItems(const sf::FloatRect& area, std::vector<Item*>& out) const {
+    itemIndex.query(area, out);
+}
+
+void Room::findDoors(const sf::FloatRect& area, std::vector<Door*>& out) const {
+    doorIndex.query(area, out);
+}
+
+float Room::getMaxDetectionRadius() const { return maxDetectionRadius; }
+
 // ============================================================================
 // Door Class Implementation
 // ============================================================================
@@ -114,7 +345,10 @@ Door::Door(float x, float y, int targetRoom, bool locked, const std::string& key
     : position(x, y),
       targetRoomID(targetRoom),
       isLocked(locked),
-      requiredKey(keyName)
+      requiredKey(keyName),
+      requiredKeyId(ItemRegistry::global().intern(keyName)),
+      events(nullptr),
+      roomID(-1)
 {
     sprite.setSize({30.0f, 60.0f});
     sprite.setPosition(position);
@@ -127,13 +361,19 @@ Door::Door(float x, float y, int targetRoom, bool locked, const std::string& key
 }
 
 void Door::unlock() {
+    bool wasLocked = isLocked;
     isLocked = false;
     sprite.setFillColor(sf::Color::Blue); // Turn Blue when unlocked
+    if (wasLocked && events) events->publish(GameEvent::Type::DOOR_UNLOCKED, requiredKeyId, roomID);
 }
 
 bool Door::canOpen(const std::string& keyName) {
+    return canOpen(ItemRegistry::global().find(keyName));
+}
+
+bool Door::canOpen(ItemId keyId) {
     if (!isLocked) return true;
-    if (keyName == requiredKey || requiredKey.empty()) {
+    if (keyId == requiredKeyId || requiredKeyId == NO_ITEM) {
         unlock();
         return true;
     }
@@ -149,9 +389,19 @@ bool Door::getLockedStatus() const { return isLocked; }
 sf::FloatRect Door::getBounds() const { return sprite.getGlobalBounds(); }
 
 // --- Dynamic Color Logic ---
-std::string Door::getRequiredKey() const { return requiredKey; }
+const std::string& Door::getRequiredKey() const { return requiredKey; }
+ItemId Door::getRequiredKeyId() const { return requiredKeyId; }
 void Door::setColor(const sf::Color& color) { sprite.setFillColor(color); }
 
-void Door::draw(sf::RenderWindow& window) {
-    window.draw(sprite);
-}
\ No newline at end of file
+void Door::setEventBus(EventBus* bus, int owningRoomID) {
+    events = bus;
+    roomID = owningRoomID;
+}
+
+void Door::draw(sf::RenderTarget& target) {
+    target.draw(sprite);
+}
+
+void Door::draw(SpriteBatch& batch) {
+    batch.add(sprite);
+}
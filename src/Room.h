@@ -6,11 +6,28 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include "SpatialHash.h"
+#include "GuardSystem.h"
+#include "ItemRegistry.h"
+#include "NavGrid.h"
+#include "PathService.h"
+#include "FlowField.h"
 
 class Puzzle;
 class Item;
 class Guard;
 class Door;
+class SpriteBatch;
+class EventBus;
+
+// PuzzleProgress - Solved/total puzzle counts, kept current as puzzles
+// flip state so "are all solved?" is one compare instead of a scan
+struct PuzzleProgress {
+    std::size_t total = 0;
+    std::size_t solved = 0;
+    
+    bool allSolved() const { return solved == total; }
+};
 
 class Room {
 private:
@@ -19,35 +36,125 @@ private:
     sf::Vector2f position;
     sf::Vector2f size;
     
-    // --- CHANGED: Replaced simple background shape with Texture/Sprite ---
-    sf::Texture bgTexture;
-    sf::Sprite bgSprite;
+    // Background image, streamed in by the presentation layer; a flat
+    // color stands in until (or unless) the texture is resident
+    std::string backgroundPath;
+    std::shared_ptr<const sf::Texture> background;
+    sf::RectangleShape backdrop;
     
     std::vector<std::shared_ptr<Puzzle>> puzzles;
     std::vector<std::shared_ptr<Item>> items;
     std::vector<std::shared_ptr<Guard>> guards;
     std::vector<std::shared_ptr<Door>> doors;
     
+    // Walls and display cases: block the player, guards path around them
+    std::vector<sf::FloatRect> obstacles;
+    std::vector<sf::RectangleShape> obstacleShapes;
+    NavGrid navGrid;          // Rebuilt whenever an obstacle is added
+    NavGrid sightGrid;        // The obstacles themselves: what blocks guards' sight
+    PathService pathService;  // Guards' path requests, searched a slice per tick
+    
+    // Alarm: every guard follows one flow field towards the intruder. The
+    // field for the intruder's cell is built on the shared worker while the
+    // previous one is in use, and swapped in on the next tick (waiting for
+    // the worker if it is late), so guards react on the same tick in every
+    // run and replays stay exact.
+    FlowField flowFields[2];
+    int activeFlow;               // Index of the field guards follow
+    FlowFieldWorker::Job flowJob; // Building flowFields[1 - activeFlow]
+    float alarmTimer;             // Seconds left; 0 when quiet
+    sf::Vector2f intruder;
+    sf::Vector2f sighting;        // Where the intruder was when the alarm went up
+    void requestFlow(int goalCell);
+    void finishFlow();
+    
+    // Simulation state of all guards in the room, stepped as one batch
+    GuardSystem guardSystem;
+    
+    // Broadphase: all proximity queries go through these grids. Guards are
+    // indexed by position (a point) and keep their entry current as they move.
+    SpatialHash<Guard> guardIndex;
+    SpatialHash<Item> itemIndex;
+    SpatialHash<Door> doorIndex;
+    float maxDetectionRadius; // Largest guard radius: how far to search around the player
+    std::vector<Guard*> nearbyGuards;        // Scratch for detectGuards
+    std::vector<std::size_t> candidateSlots; // Their slots, sorted
+    
     bool isExitRoom;
     bool isVisited;
     
+    EventBus* events; // Handed to every door added to the room; puzzles read it from here
+    void contentsChanged(); // ROOM_CONTENTS_CHANGED, when there is a bus
+    
+    PuzzleProgress progress;        // This room's puzzles
+    PuzzleProgress* worldProgress;  // Every attached room's puzzles (optional)
+    
 public:
     // --- CHANGED: Added imagePath parameter ---
     Room(int id, const std::string& name, float x, float y, float width, float height, const std::string& imagePath);
     
+    ~Room(); // Waits for a flow field still being built
+    
+    // The guard system and path service point at this room's members
+    Room(const Room&) = delete;
+    Room& operator=(const Room&) = delete;
+    
+    // Background texture (presentation only; headless runs never set one)
+    void setBackground(std::shared_ptr<const sf::Texture> texture);
+    bool hasBackground() const;
+    const std::string& getBackgroundPath() const;
+    
+    // Doors and puzzles (present and future) publish their changes here
+    void setEventBus(EventBus* bus);
+    EventBus* getEventBus() const;
+    
     // Puzzle management
     void addPuzzle(std::shared_ptr<Puzzle> puzzle);
     std::vector<std::shared_ptr<Puzzle>>& getPuzzles();
-    bool allPuzzlesSolved() const;
+    bool allPuzzlesSolved() const; // O(1): counters, not a scan
+    const PuzzleProgress& getPuzzleProgress() const;
+    // Add this room's counts into a world total that then follows it.
+    // countTotals = false when the world total already includes them.
+    void attachProgress(PuzzleProgress* world, bool countTotals = true);
+    // Called by a puzzle of this room whenever its solved state flips
+    void onPuzzleSolvedChanged(bool solved);
     
     // Item management
+    // Adding, removing and collecting publish ROOM_CONTENTS_CHANGED, as do
+    // addDoor and addObstacle: what the room looks like has changed
     void addItem(std::shared_ptr<Item> item);
     void removeItem(std::shared_ptr<Item> item);
+    void collectItem(Item& item); // Picked up: stays indexed, no longer drawn
     std::vector<std::shared_ptr<Item>>& getItems();
     
     // Guard management
     void addGuard(std::shared_ptr<Guard> guard);
     std::vector<std::shared_ptr<Guard>>& getGuards();
+    GuardSystem& getGuardSystem();
+    
+    // Batch guard simulation: search pending paths, save previous positions,
+    // cooldowns and patrol for every guard, then bring the guard index up
+    // to date
+    void updateGuards(float deltaTime);
+    // Alarm: for the next seconds, every guard converges on the intruder,
+    // then investigates where it was seen before going back to patrol.
+    // trackIntruder() before each updateGuards.
+    void raiseAlarm(float seconds);
+    bool isAlarmRaised() const;
+    void trackIntruder(const sf::Vector2f& position);
+    // Slots (in getGuardSystem) of guards that see a player at this position:
+    // the guard index narrows the search to guards within
+    // maxDetectionRadius, then the batch kernels test those
+    void detectGuards(const sf::Vector2f& playerPosition, std::vector<std::size_t>& hits);
+    
+    // Obstacles (add them before the guards, whose first legs are planned
+    // on the grid as they join)
+    void addObstacle(const sf::FloatRect& bounds);
+    const std::vector<sf::FloatRect>& getObstacles() const;
+    bool isBlocked(const sf::FloatRect& bounds) const; // Overlaps any obstacle
+    const NavGrid& getNavGrid() const;
+    const NavGrid& getSightGrid() const;
+    PathService& getPathService();
     
     // Door management
     void addDoor(std::shared_ptr<Door> door);
@@ -68,10 +175,23 @@ public:
     
     // Update and render
     void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
+    // showVisionCones = false when a lighting pass draws them instead.
+    // draw() is drawStatic() then drawGuards(); with an atlas, doors,
+    // items and guards go into batch for the caller to submit.
+    void draw(sf::RenderTarget& target, SpriteBatch& batch, bool showVisionCones = true);
+    // What only changes on gameplay events: background, obstacles, doors
+    // and uncollected items (see StaticLayer)
+    void drawStatic(sf::RenderTarget& target, SpriteBatch& batch);
+    void drawGuards(sf::RenderTarget& target, SpriteBatch& batch, bool showVisionCones = true);
     
     // Collision check
     bool containsPoint(const sf::Vector2f& point) const;
+    
+    // Proximity queries (broadphase candidates; callers run the exact test)
+    void findGuardsNear(const sf::Vector2f& point, float radius, std::vector<Guard*>& out) const;
+    void findItems(const sf::FloatRect& area, std::vector<Item*>& out) const;
+    void findDoors(const sf::FloatRect& area, std::vector<Door*>& out) const;
+    float getMaxDetectionRadius() const;
 };
 
 // Door class - Connects rooms
@@ -82,12 +202,17 @@ private:
     int targetRoomID;
     bool isLocked;
     std::string requiredKey; // Key name required to unlock
+    ItemId requiredKeyId;    // Interned requiredKey (NO_ITEM: no key)
+    
+    EventBus* events; // DOOR_UNLOCKED goes here (set by the owning room)
+    int roomID;
     
 public:
     Door(float x, float y, int targetRoom, bool locked = false, const std::string& keyName = "");
     
     void unlock();
     bool canOpen(const std::string& keyName);
+    bool canOpen(ItemId keyId);
     bool checkCollision(const sf::FloatRect& bounds);
     
     int getTargetRoomID() const;
@@ -95,10 +220,13 @@ public:
     sf::FloatRect getBounds() const;
     
     // --- NEW: Added getters/setters for logic in Game.cpp ---
-    std::string getRequiredKey() const;
+    const std::string& getRequiredKey() const;
+    ItemId getRequiredKeyId() const;
     void setColor(const sf::Color& color);
+    void setEventBus(EventBus* bus, int owningRoomID);
     
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderTarget& target);
+    void draw(SpriteBatch& batch);
 };
 
 #endif // ROOM_H
\ No newline at end of file
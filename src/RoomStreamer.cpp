@@ -0,0 +1,156 @@
+/*
+ * Museum Escape - Room Streamer Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "RoomStreamer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+RoomStreamer::RoomStreamer(std::size_t budgetBytes)
+    : budget(budgetBytes),
+      residentBytes(0),
+      focusCount(0),
+      archive(nullptr),
+      stopping(false)
+{
+    worker = std::thread(&RoomStreamer::run, this);
+}
+
+RoomStreamer::~RoomStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+// Worker: decode one file at a time, outside the lock
+void RoomStreamer::run() {
+    PROFILE_THREAD("RoomStreamer");
+    for (;;) {
+        std::string path;
+        const AssetArchive* source;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            path = std::move(queue.front());
+            queue.pop_front();
+            source = archive;
+        }
+
+        PROFILE_SCOPE("RoomStreamer::decode");
+        auto image = std::make_unique<sf::Image>();
+        bool loaded = source ? source->load(*image, path) : image->loadFromFile(path);
+        if (!loaded) image.reset();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded.push_back({std::move(path), std::move(image)});
+    }
+}
+
+void RoomStreamer::setArchive(const AssetArchive* assetArchive) {
+    std::lock_guard<std::mutex> lock(mutex);
+    archive = assetArchive;
+}
+
+void RoomStreamer::focus(const std::vector<std::string>& paths) {
+    focusCount++;
+    pinned = paths;
+
+    std::vector<std::string> requests;
+    for (const std::string& path : paths) {
+        if (path.empty()) continue;
+        Entry& entry = entries[path];
+        entry.lastWanted = focusCount;
+        if (!entry.texture && !entry.requested && !entry.failed) {
+            entry.requested = true;
+            requests.push_back(path);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Whatever the player walked away from before it was decoded
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (std::find(paths.begin(), paths.end(), *it) == paths.end()) {
+                entries[*it].requested = false;
+                it = queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        queue.insert(queue.end(), requests.begin(), requests.end());
+    }
+    if (!requests.empty()) wake.notify_one();
+    evict();
+}
+
+void RoomStreamer::update(std::size_t maxUploads) {
+    std::vector<Decoded> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (decoded.empty()) return;
+        std::size_t count = std::min(maxUploads, decoded.size());
+        std::move(decoded.begin(), decoded.begin() + count, std::back_inserter(ready));
+        decoded.erase(decoded.begin(), decoded.begin() + count);
+    }
+
+    PROFILE_SCOPE("RoomStreamer::upload");
+    for (Decoded& result : ready) {
+        Entry& entry = entries[result.path];
+        entry.requested = false;
+        auto texture = std::make_shared<sf::Texture>();
+        if (!result.image || !texture->loadFromImage(*result.image)) {
+            std::cout << "Warning: Could not load " << result.path << ". Using default color." << std::endl;
+            entry.failed = true;
+            continue;
+        }
+        texture->setSmooth(true);
+        sf::Vector2u size = texture->getSize();
+        entry.texture = texture;
+        entry.bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+        residentBytes += entry.bytes;
+    }
+    evict();
+}
+
+void RoomStreamer::evict() {
+    while (residentBytes > budget) {
+        Entry* oldest = nullptr;
+        for (auto& pair : entries) {
+            Entry& entry = pair.second;
+            if (!entry.texture) continue;
+            if (std::find(pinned.begin(), pinned.end(), pair.first) != pinned.end()) continue;
+            if (!oldest || entry.lastWanted < oldest->lastWanted) oldest = &entry;
+        }
+        if (!oldest) return; // Everything resident is wanted right now
+
+        residentBytes -= oldest->bytes;
+        oldest->texture.reset();
+        oldest->bytes = 0;
+    }
+}
+
+TextureHandle RoomStreamer::get(const std::string& path) const {
+    auto it = entries.find(path);
+    return it != entries.end() ? it->second.texture : nullptr;
+}
+
+void RoomStreamer::setBudget(std::size_t bytes) {
+    budget = bytes;
+    evict();
+}
+
+std::size_t RoomStreamer::getResidentBytes() const { return residentBytes; }
+
+std::size_t RoomStreamer::getResidentCount() const {
+    std::size_t count = 0;
+    for (const auto& pair : entries) if (pair.second.texture) count++;
+    return count;
+}
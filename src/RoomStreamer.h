@@ -0,0 +1,89 @@
+#ifndef ROOM_STREAMER_H
+#define ROOM_STREAMER_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ResourceCache.h"
+#include "AssetArchive.h"
+
+// RoomStreamer - Background images, streamed. A worker thread decodes
+// image files; update() uploads finished decodes as textures on the render
+// thread, a few per frame. focus() names the images wanted now (the
+// current room first, then its door neighbours); everything else is
+// evicted least-recently-wanted first once the budget is exceeded.
+// Nothing here ever blocks the caller on disk or decoding. With an archive
+// set, images are decoded from it and only missing ones from loose files.
+class RoomStreamer {
+public:
+    static const std::size_t DEFAULT_BUDGET = 64u * 1024u * 1024u; // Texture bytes
+    static const std::size_t UPLOADS_PER_FRAME = 1;
+
+private:
+    struct Entry {
+        TextureHandle texture;
+        std::size_t bytes = 0;
+        unsigned long long lastWanted = 0;
+        bool requested = false; // Queued or decoding
+        bool failed = false;    // Missing or unreadable: not retried
+    };
+
+    struct Decoded {
+        std::string path;
+        std::unique_ptr<sf::Image> image; // Null when decoding failed
+    };
+
+    // Render thread only
+    std::unordered_map<std::string, Entry> entries;
+    std::vector<std::string> pinned; // Last focus set: never evicted
+    std::size_t budget;
+    std::size_t residentBytes;
+    unsigned long long focusCount;
+
+    // Shared with the worker
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::string> queue;
+    const AssetArchive* archive;
+    std::vector<Decoded> decoded;
+    bool stopping;
+    std::thread worker;
+
+    void run();
+    void evict();
+
+public:
+    // Constructor - starts the worker thread
+    RoomStreamer(std::size_t budgetBytes = DEFAULT_BUDGET);
+    ~RoomStreamer();
+
+    RoomStreamer(const RoomStreamer&) = delete;
+    RoomStreamer& operator=(const RoomStreamer&) = delete;
+
+    // Decode from this archive (read-only, so safe to share with the worker);
+    // it must stay open for the streamer's lifetime
+    void setArchive(const AssetArchive* assetArchive);
+
+    // Images wanted now, most important first. Queued decodes of anything
+    // no longer wanted are dropped.
+    void focus(const std::vector<std::string>& paths);
+
+    // Upload up to maxUploads finished decodes; call once per frame
+    void update(std::size_t maxUploads = UPLOADS_PER_FRAME);
+
+    // Resident texture, or null while it is still streaming in
+    TextureHandle get(const std::string& path) const;
+
+    void setBudget(std::size_t bytes);
+    std::size_t getResidentBytes() const;
+    std::size_t getResidentCount() const;
+};
+
+#endif // ROOM_STREAMER_H
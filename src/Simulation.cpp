@@ -0,0 +1,488 @@
+/*
+ * Museum Escape - Simulation Class Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Simulation.h"
+#include "Puzzle.h"
+#include "Guard.h"
+#include "Item.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+const char* const Simulation::DEFAULT_LEVEL = "assets/levels/museum.level";
+
+// How long the room's guards converge on the player after the warning
+static const float ALARM_DURATION = 6.0f;
+
+Simulation::Simulation(const sf::Texture& playerTex, const sf::Texture& guardTex, std::uint32_t rngSeed)
+    : currentState(GameState::MENU),
+      currentRoomID(1),
+      activePuzzle(nullptr),
+      notificationTimer(0.0f),
+      notificationColor(sf::Color::White),
+      playerTexture(playerTex),
+      guardTexture(guardTex),
+      tickCount(0),
+      logEvents(true),
+      seed(rngSeed),
+      font(std::make_shared<sf::Font>())
+{
+    subscribeEvents();
+    if (!LevelLoader::load(DEFAULT_LEVEL, level)) std::cerr << "Warning: Starting with an empty level." << std::endl;
+    indexLevel();
+    restart();
+}
+
+bool Simulation::loadLevel(const std::string& path) {
+    LevelData loaded;
+    if (!LevelLoader::load(path, loaded)) return false;
+    level = std::move(loaded);
+    indexLevel();
+    restart();
+    return true;
+}
+
+void Simulation::indexLevel() {
+    levelRooms.clear();
+    for (std::size_t i = 0; i < level.rooms.size(); i++) levelRooms[level.rooms[i].id] = i;
+}
+
+const LevelData& Simulation::getLevel() const { return level; }
+
+std::string Simulation::getRoomBackgroundPath(int roomID) const {
+    auto built = rooms.find(roomID);
+    if (built != rooms.end()) return built->second->getBackgroundPath();
+    auto record = levelRooms.find(roomID);
+    return record != levelRooms.end() ? level.string(level.rooms[record->second].background) : "";
+}
+
+Simulation::~Simulation() {}
+
+// Build a fresh world and go back to the menu
+void Simulation::restart() {
+    rng.seed(seed);
+    tickCount = 0;
+    currentState = GameState::MENU;
+    currentRoomID = level.startRoom;
+    activePuzzle = nullptr;
+    notificationTimer = 0.0f;
+    rooms.clear();
+    
+    player = std::make_unique<Player>(100.0f, 100.0f, playerTexture);
+    gameTimer = std::make_unique<Timer>(600.0f);
+    gameTimer->setDisplayPosition(650.0f, 20.0f);
+    inventory = std::make_unique<Inventory>(10);
+    inventory->setEventBus(&events);
+    
+    // Rooms are built on first entry; the totals are known from the level
+    puzzleProgress = PuzzleProgress();
+    puzzleProgress.total = level.puzzles.size();
+    if (!ensureRoom(currentRoomID)) {
+        // Never run without a room to stand in
+        auto fallback = std::make_shared<Room>(currentRoomID, "Empty Room", 0, 0, 800, 600, "");
+        rooms[currentRoomID] = fallback;
+        attachRoom(*fallback);
+    }
+    applyFont();
+    events.publish(GameEvent::Type::ROOM_CHANGED, NO_ITEM, currentRoomID);
+}
+
+void Simulation::restart(std::uint32_t rngSeed) {
+    seed = rngSeed;
+    restart();
+}
+
+void Simulation::step(float deltaTime, const TickInput& input) {
+    for (const InputEvent& event : input.events) handleEvent(event.toEvent());
+    update(deltaTime, input.held);
+}
+
+void Simulation::handleEvent(const sf::Event& event) {
+    switch (currentState) {
+        case GameState::MENU: handleMenuInput(event); break;
+        case GameState::PLAYING: handlePlayingInput(event); break;
+        case GameState::PUZZLE_ACTIVE: handlePuzzleInput(event); break;
+        case GameState::PAUSED: handlePauseInput(event); break;
+        default: break;
+    }
+}
+
+void Simulation::update(float deltaTime, const PlayerInput& input) {
+    tickCount++;
+    switch (currentState) {
+        case GameState::PLAYING: updatePlaying(deltaTime, input); break;
+        case GameState::PUZZLE_ACTIVE: holdStill(); updatePuzzle(deltaTime); break;
+        default: holdStill(); break;
+    }
+}
+
+// Outside play nothing moves, but the screens over the room still draw it
+// interpolated: make the last tick's motion complete so sprites stay put
+void Simulation::holdStill() {
+    player->savePreviousPosition();
+    auto it = rooms.find(currentRoomID);
+    if (it != rooms.end()) it->second->getGuardSystem().savePreviousPositions();
+}
+
+void Simulation::updatePlaying(float deltaTime, const PlayerInput& input) {
+    PROFILE_SCOPE("Simulation::updatePlaying");
+    // Remember where the player was before this tick for render interpolation
+    // (the room's guard system does the same for its guards)
+    player->savePreviousPosition();
+    
+    gameTimer->update(deltaTime);
+    if (notificationTimer > 0) notificationTimer -= deltaTime;
+    player->handleInput(input, deltaTime);
+    player->update(deltaTime);
+    
+    if (rooms.find(currentRoomID) != rooms.end()) {
+        rooms[currentRoomID]->update(deltaTime);
+        
+        // Update Guards (Keep moving!) - one batch for the whole room.
+        // Door colors and the win check follow events instead (see subscribeEvents)
+        rooms[currentRoomID]->trackIntruder(player->getPosition());
+        rooms[currentRoomID]->updateGuards(deltaTime);
+    }
+    
+    checkCollisions();
+    checkGuardDetection();
+    checkLoseCondition();
+}
+
+void Simulation::updatePuzzle(float deltaTime) { if (activePuzzle) activePuzzle->update(deltaTime); }
+
+// Building a room from the flat level data is cheap (no disk access, no
+// images), so it happens synchronously, and deterministically, on entry
+std::shared_ptr<Room> Simulation::ensureRoom(int roomID) {
+    auto built = rooms.find(roomID);
+    if (built != rooms.end()) return built->second;
+    
+    auto record = levelRooms.find(roomID);
+    if (record == levelRooms.end()) return nullptr;
+    std::shared_ptr<Room> room = LevelLoader::buildRoom(level, record->second, guardTexture);
+    rooms[roomID] = room;
+    attachRoom(*room);
+    for (auto& puzzle : room->getPuzzles()) puzzle->setFont(font);
+    return room;
+}
+
+void Simulation::attachRoom(Room& room) {
+    room.setEventBus(&events);
+    room.attachProgress(&puzzleProgress, false);
+}
+
+// Derived state is recomputed only when something it depends on changes
+void Simulation::subscribeEvents() {
+    auto inventoryChanged = [this](const GameEvent&) {
+        auto it = rooms.find(currentRoomID);
+        if (it != rooms.end()) refreshDoorColors(*it->second);
+    };
+    events.subscribe(GameEvent::Type::ITEM_COLLECTED, inventoryChanged);
+    events.subscribe(GameEvent::Type::ITEM_REMOVED, inventoryChanged);
+    
+    events.subscribe(GameEvent::Type::ROOM_CHANGED, [this](const GameEvent& event) {
+        auto it = rooms.find(event.roomID);
+        if (it != rooms.end()) refreshDoorColors(*it->second);
+        checkWinCondition();
+    });
+    events.subscribe(GameEvent::Type::PUZZLE_SOLVED, [this](const GameEvent&) { checkWinCondition(); });
+}
+
+void Simulation::refreshDoorColors(Room& room) {
+    for (auto& door : room.getDoors()) {
+        if (door->getLockedStatus()) {
+            // Interned IDs: a bit test per door, no string compares
+            if (player->hasItem(door->getRequiredKeyId())) {
+                door->setColor(sf::Color::Blue); // READY
+            } else {
+                door->setColor(sf::Color::Red); // LOCKED
+            }
+        }
+    }
+}
+
+void Simulation::handleMenuInput(const sf::Event& event) {
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (keyPressed->code == sf::Keyboard::Key::Enter) {
+            currentState = GameState::PLAYING;
+            gameTimer->start();
+            if (logEvents) std::cout << "Game Started!" << std::endl;
+            // The start room never changes into: check it here (an exit
+            // room with nothing left to solve wins at once)
+            checkWinCondition();
+        }
+    }
+}
+
+void Simulation::handlePlayingInput(const sf::Event& event) {
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (keyPressed->code == sf::Keyboard::Key::Space) pauseGame();
+        if (keyPressed->code == sf::Keyboard::Key::I) inventory->toggleVisibility();
+        if (keyPressed->code == sf::Keyboard::Key::E) { checkDoorInteraction(); checkItemPickup(); }
+        if (keyPressed->code == sf::Keyboard::Key::P) checkPuzzleInteraction();
+    }
+}
+
+void Simulation::handlePuzzleInput(const sf::Event& event) {
+    if (activePuzzle) {
+        bool wasSolved = activePuzzle->isSolvedStatus();
+        activePuzzle->handleInput(const_cast<sf::Event&>(event));
+        if (!wasSolved && activePuzzle->isSolvedStatus()) {
+            gameTimer->addTime(activePuzzle->getTimeBonus());
+            showNotification("Puzzle Solved! +" + std::to_string(activePuzzle->getTimeBonus()) + "s", sf::Color::Green, 3.0f);
+            // Rewards come from the level file
+            for (const auto& reward : activePuzzle->getRewards()) {
+                rooms[currentRoomID]->addItem(reward);
+                showNotification(reward->getName() + " appeared!", sf::Color::Yellow, 4.0f);
+            }
+        }
+    }
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (keyPressed->code == sf::Keyboard::Key::Escape) {
+            activePuzzle = nullptr;
+            currentState = GameState::PLAYING;
+            gameTimer->resume();
+        }
+    }
+}
+
+void Simulation::handlePauseInput(const sf::Event& event) {
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (keyPressed->code == sf::Keyboard::Key::Space) resumeGame();
+    }
+}
+
+void Simulation::changeRoom(int newRoomID) {
+    if (ensureRoom(newRoomID)) {
+        currentRoomID = newRoomID;
+        rooms[currentRoomID]->setVisited(true);
+        player->teleport(100.0f, 300.0f);
+        if (logEvents) std::cout << "\n→ Moved to: " << rooms[currentRoomID]->getRoomName() << std::endl;
+        events.publish(GameEvent::Type::ROOM_CHANGED, NO_ITEM, currentRoomID);
+    }
+}
+
+void Simulation::activatePuzzle(std::shared_ptr<Puzzle> puzzle) {
+    activePuzzle = puzzle;
+    currentState = GameState::PUZZLE_ACTIVE;
+    gameTimer->pause();
+}
+
+void Simulation::checkCollisions() {
+    auto playerBounds = player->getBounds();
+    sf::Vector2f pos = player->getPosition();
+    if (pos.x < 0) player->setPosition(0, pos.y);
+    if (pos.y < 0) player->setPosition(pos.x, 0);
+    if (pos.x > 800 - playerBounds.size.x) player->setPosition(800 - playerBounds.size.x, pos.y);
+    if (pos.y > 600 - playerBounds.size.y) player->setPosition(pos.x, 600 - playerBounds.size.y);
+    
+    // Obstacles: slide along them, keeping whichever axis of the move is free
+    auto it = rooms.find(currentRoomID);
+    if (it == rooms.end() || it->second->getObstacles().empty()) return;
+    Room& room = *it->second;
+    pos = player->getPosition();
+    playerBounds = player->getBounds();
+    if (!room.isBlocked(playerBounds)) return;
+    
+    sf::Vector2f previous = player->getPreviousPosition();
+    sf::Vector2f offset = playerBounds.position - pos; // Bounds may not start at the position
+    if (!room.isBlocked(sf::FloatRect(sf::Vector2f(previous.x, pos.y) + offset, playerBounds.size))) {
+        player->setPosition(previous.x, pos.y);
+    } else if (!room.isBlocked(sf::FloatRect(sf::Vector2f(pos.x, previous.y) + offset, playerBounds.size))) {
+        player->setPosition(pos.x, previous.y);
+    } else {
+        player->setPosition(previous.x, previous.y);
+    }
+}
+
+void Simulation::checkGuardDetection() {
+    // Guards near the player from the room's index, then squared-distance
+    // and vision tests over their slots in one batch
+    rooms[currentRoomID]->detectGuards(player->getPosition(), guardDetections);
+    for (std::size_t i = 0; i < guardDetections.size(); i++) {
+        if (!player->isPlayerWarned()) {
+            player->warn();
+            showNotification("WARNING! Caught by guard!", sf::Color::Yellow, 3.0f);
+            gameTimer->subtractTime(5.0f);
+            // Alarm: every guard in the room converges on the player
+            rooms[currentRoomID]->raiseAlarm(ALARM_DURATION);
+        } else {
+            showNotification("CAUGHT! Game Over!", sf::Color::Red, 2.0f);
+            setGameOver(false);
+            return;
+        }
+    }
+}
+
+void Simulation::checkDoorInteraction() {
+    auto playerBounds = player->getBounds();
+    rooms[currentRoomID]->findDoors(playerBounds, nearbyDoors);
+    for (Door* door : nearbyDoors) {
+        if (door->checkCollision(playerBounds)) {
+            if (door->getLockedStatus()) {
+                const std::string& requiredKey = door->getRequiredKey();
+                if (player->hasItem(door->getRequiredKeyId())) {
+                    door->unlock();
+                    showNotification("Door unlocked with " + requiredKey + "!", sf::Color::Green, 2.0f);
+                    changeRoom(door->getTargetRoomID());
+                } else {
+                    showNotification("LOCKED! Need " + requiredKey, sf::Color::Red, 2.0f);
+                }
+            } else {
+                changeRoom(door->getTargetRoomID());
+            }
+            return;
+        }
+    }
+}
+
+void Simulation::checkItemPickup() {
+    auto playerBounds = player->getBounds();
+    rooms[currentRoomID]->findItems(playerBounds, nearbyItems);
+    for (Item* item : nearbyItems) {
+        if (!item->isItemCollected() && item->checkCollision(playerBounds)) {
+            rooms[currentRoomID]->collectItem(*item);
+            player->addItem(item);
+            inventory->addItem(item->shared_from_this());
+            
+            if (Passcode* passcode = dynamic_cast<Passcode*>(item)) {
+                std::string title = item->getName();
+                std::transform(title.begin(), title.end(), title.begin(), ::toupper);
+                showNotification(title + ": " + passcode->getCode(), sf::Color::Yellow, 10.0f);
+            } else {
+                showNotification("Picked up: " + item->getName(), sf::Color::Cyan, 2.0f);
+            }
+        }
+    }
+}
+
+void Simulation::checkPuzzleInteraction() {
+    auto& puzzles = rooms[currentRoomID]->getPuzzles();
+    for (auto& puzzle : puzzles) {
+        if (!puzzle->isSolvedStatus()) {
+            activatePuzzle(puzzle);
+            if (!puzzle->getPrompt().empty()) showNotification(puzzle->getPrompt(), sf::Color::Magenta, 4.0f);
+            return;
+        }
+    }
+}
+
+// Runs on ROOM_CHANGED and PUZZLE_SOLVED, and once as play starts
+void Simulation::checkWinCondition() {
+    if (currentState != GameState::PLAYING && currentState != GameState::PUZZLE_ACTIVE) return;
+    auto room = rooms.find(currentRoomID);
+    if (room != rooms.end() && room->second->isExit()) {
+        // Counters are kept by the rooms as puzzles flip: no scan
+        if (puzzleProgress.allSolved()) setGameOver(true);
+        else showNotification("Solve ALL puzzles to escape!", sf::Color::Red, 2.0f);
+    }
+}
+
+void Simulation::checkLoseCondition() {
+    if (gameTimer->isExpired()) setGameOver(false);
+}
+
+void Simulation::setGameOver(bool victory) {
+    currentState = victory ? GameState::VICTORY : GameState::GAME_OVER;
+    gameTimer->stop();
+}
+
+void Simulation::pauseGame() {
+    currentState = GameState::PAUSED;
+    gameTimer->pause();
+}
+
+void Simulation::resumeGame() {
+    currentState = GameState::PLAYING;
+    gameTimer->resume();
+}
+
+void Simulation::showNotification(const std::string& message, const sf::Color& color, float duration) {
+    currentNotification = message;
+    notificationColor = color;
+    notificationTimer = duration;
+}
+
+void Simulation::setLogging(bool enabled) { logEvents = enabled; }
+EventBus& Simulation::getEvents() { return events; }
+
+void Simulation::setFont(FontHandle f) {
+    if (!f) return;
+    font = f;
+    applyFont();
+}
+
+void Simulation::applyFont() {
+    gameTimer->setFont(font);
+    inventory->setFont(font);
+    for (auto& roomPair : rooms) {
+        for (auto& puzzle : roomPair.second->getPuzzles()) puzzle->setFont(font);
+    }
+}
+
+std::uint32_t Simulation::getSeed() const { return seed; }
+std::mt19937& Simulation::getRng() { return rng; }
+
+GameState Simulation::getState() const { return currentState; }
+Player& Simulation::getPlayer() { return *player; }
+Timer& Simulation::getTimer() { return *gameTimer; }
+Inventory& Simulation::getInventory() { return *inventory; }
+std::map<int, std::shared_ptr<Room>>& Simulation::getRooms() { return rooms; }
+
+std::shared_ptr<Room> Simulation::getCurrentRoom() {
+    auto it = rooms.find(currentRoomID);
+    return it != rooms.end() ? it->second : nullptr;
+}
+
+int Simulation::getCurrentRoomID() const { return currentRoomID; }
+std::shared_ptr<Puzzle> Simulation::getActivePuzzle() { return activePuzzle; }
+const PuzzleProgress& Simulation::getPuzzleProgress() const { return puzzleProgress; }
+
+bool Simulation::hasNotification() const { return notificationTimer > 0; }
+const std::string& Simulation::getNotification() const { return currentNotification; }
+sf::Color Simulation::getNotificationColor() const { return notificationColor; }
+
+unsigned long long Simulation::getTickCount() const { return tickCount; }
+
+namespace {
+    // FNV-1a over the raw bytes of each value
+    void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    template <typename T>
+    void hashValue(std::uint64_t& hash, const T& value) { hashBytes(hash, &value, sizeof(value)); }
+}
+
+std::uint64_t Simulation::checksum() const {
+    std::uint64_t hash = 14695981039346656037ULL;
+    hashValue(hash, static_cast<int>(currentState));
+    hashValue(hash, currentRoomID);
+    hashValue(hash, tickCount);
+    hashValue(hash, gameTimer->getRemainingTime());
+    sf::Vector2f playerPos = player->getPosition();
+    hashValue(hash, playerPos.x);
+    hashValue(hash, playerPos.y);
+    hashValue(hash, player->isPlayerWarned());
+    hashValue(hash, player->getInventory().size());
+
+    for (const auto& roomPair : rooms) {
+        Room& room = *roomPair.second;
+        for (const auto& guard : room.getGuards()) {
+            sf::Vector2f guardPos = guard->getPosition();
+            hashValue(hash, guardPos.x);
+            hashValue(hash, guardPos.y);
+        }
+        for (const auto& puzzle : room.getPuzzles()) hashValue(hash, puzzle->isSolvedStatus());
+        for (const auto& door : room.getDoors()) hashValue(hash, door->getLockedStatus());
+        hashValue(hash, room.getItems().size());
+    }
+    return hash;
+}
@@ -0,0 +1,185 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <random>
+#include <cstdint>
+#include "Input.h"
+#include "ResourceCache.h"
+#include "Player.h"
+#include "Room.h"
+#include "Timer.h"
+#include "Item.h"
+#include "EventBus.h"
+#include "Level.h"
+
+class Puzzle;
+
+enum class GameState {
+    MENU,
+    PLAYING,
+    PAUSED,
+    PUZZLE_ACTIVE,
+    GAME_OVER,
+    VICTORY
+};
+
+// Simulation - The window-free game core: state machine, rooms, player,
+// guards, puzzles, timer and win/lose rules. Never touches a RenderWindow,
+// so it can be stepped headless as fast as the CPU allows. Game renders it.
+class Simulation {
+private:
+    // Game state
+    GameState currentState;
+    
+    // Gameplay changes; derived state is updated from here, not per tick.
+    // Outlives every world rebuild, so subscriptions persist across restarts.
+    EventBus events;
+
+    // Core components
+    std::unique_ptr<Player> player;
+    std::unique_ptr<Timer> gameTimer;
+    std::unique_ptr<Inventory> inventory;
+
+    // Rooms built so far (on first entry), by ID
+    std::map<int, std::shared_ptr<Room>> rooms;
+    int currentRoomID;
+    PuzzleProgress puzzleProgress; // All rooms' puzzles, kept by the rooms
+    
+    // Level the world is built from; loaded once, rebuilt from on restart
+    LevelData level;
+    std::unordered_map<int, std::size_t> levelRooms; // Room ID -> index in level.rooms
+    void indexLevel();
+
+    // Active puzzle (when player interacts with one)
+    std::shared_ptr<Puzzle> activePuzzle;
+
+    // Notification system (rendered by the presentation layer)
+    std::string currentNotification;
+    float notificationTimer;
+    sf::Color notificationColor;
+
+    // Textures entities are created with (may be empty when headless)
+    const sf::Texture& playerTexture;
+    const sf::Texture& guardTexture;
+
+    unsigned long long tickCount; // Ticks since the last restart
+    bool logEvents; // Console messages (off for headless batch runs)
+
+    // All gameplay randomness must come from rng so a seed plus an input
+    // log reproduces a session exactly
+    std::uint32_t seed;
+    std::mt19937 rng;
+
+    // Broadphase query results, reused every tick
+    std::vector<std::size_t> guardDetections;
+    std::vector<Door*> nearbyDoors;
+    std::vector<Item*> nearbyItems;
+
+    // Font for timer, inventory and puzzle screens. Headless runs keep the
+    // empty default: puzzle buttons still need their hit areas.
+    FontHandle font;
+    void applyFont();
+
+    // Initialization
+    void subscribeEvents();
+    
+    // Build a room from the level the first time it is needed
+    std::shared_ptr<Room> ensureRoom(int roomID);
+    void attachRoom(Room& room); // Hook a new room up to the bus and puzzle totals
+
+    // State-specific handlers
+    void handleMenuInput(const sf::Event& event);
+    void handlePlayingInput(const sf::Event& event);
+    void handlePuzzleInput(const sf::Event& event);
+    void handlePauseInput(const sf::Event& event);
+
+    void updatePlaying(float deltaTime, const PlayerInput& input);
+    void updatePuzzle(float deltaTime);
+    void holdStill(); // Non-playing ticks: previous = current for everything drawn
+
+    // Game mechanics
+    void changeRoom(int newRoomID);
+    void activatePuzzle(std::shared_ptr<Puzzle> puzzle);
+    void checkCollisions();
+    void checkGuardDetection();
+    void checkDoorInteraction();
+    void checkItemPickup();
+    void checkPuzzleInteraction();
+
+    // Event-driven derived state
+    void refreshDoorColors(Room& room);
+    
+    // Win/Lose conditions
+    void checkWinCondition();
+    void checkLoseCondition();
+    void setGameOver(bool victory);
+
+    void pauseGame();
+    void resumeGame();
+    void showNotification(const std::string& message, const sf::Color& color, float duration = 3.0f);
+
+public:
+    static const std::uint32_t DEFAULT_SEED = 0x4D455343; // "MESC"
+    static const char* const DEFAULT_LEVEL;
+
+    // Constructor - textures are only referenced, never drawn here
+    Simulation(const sf::Texture& playerTex, const sf::Texture& guardTex, std::uint32_t rngSeed = DEFAULT_SEED);
+    ~Simulation();
+
+    // One fixed tick: the tick's discrete events in order, then movement.
+    // Live play, headless scripts and replays all go through here.
+    void step(float deltaTime, const TickInput& input);
+
+    // Discrete input (key presses, text, clicks), dispatched by state
+    void handleEvent(const sf::Event& event);
+
+    // Advance one fixed tick
+    void update(float deltaTime, const PlayerInput& input);
+
+    // Replace the level (text or compiled) and restart into it
+    bool loadLevel(const std::string& path);
+    const LevelData& getLevel() const;
+    // Without building the room (for preloading its image)
+    std::string getRoomBackgroundPath(int roomID) const;
+    
+    // Back to the main menu with a freshly built world
+    void restart();
+    void restart(std::uint32_t rngSeed);
+
+    void setLogging(bool enabled);
+    void setFont(FontHandle f);
+    
+    // Gameplay events (the presentation layer subscribes for HUD updates)
+    EventBus& getEvents();
+
+    std::uint32_t getSeed() const;
+    std::mt19937& getRng();
+
+    // Hash of the gameplay state (positions, timer, room, progress); equal
+    // checksums after a replay mean the session was reproduced bit for bit
+    std::uint64_t checksum() const;
+
+    // Read access for the presentation layer
+    GameState getState() const;
+    Player& getPlayer();
+    Timer& getTimer();
+    Inventory& getInventory();
+    std::map<int, std::shared_ptr<Room>>& getRooms(); // Only those built so far
+    std::shared_ptr<Room> getCurrentRoom();
+    int getCurrentRoomID() const;
+    std::shared_ptr<Puzzle> getActivePuzzle();
+    const PuzzleProgress& getPuzzleProgress() const;
+
+    bool hasNotification() const;
+    const std::string& getNotification() const;
+    sf::Color getNotificationColor() const;
+
+    unsigned long long getTickCount() const;
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,156 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// SpatialHash - Uniform grid broadphase over a fixed area. Each object is
+// listed in every cell its bounds touch; a query visits only the cells
+// under the query rectangle, so lookups cost O(objects per cell) instead
+// of O(objects in the room). Objects outside the area are clamped into the
+// border cells. Results are candidates: callers still run their exact test.
+template <typename T>
+class SpatialHash {
+private:
+    struct Entry {
+        T* object;
+        sf::FloatRect bounds;
+    };
+
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+        bool operator==(const CellRange& other) const {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+
+    sf::Vector2f origin;
+    float cellSize;
+    float inverseCellSize;
+    int columns;
+    int rows;
+    std::vector<std::vector<Entry>> cells;
+    std::size_t objectCount;
+
+    int cellX(float x) const {
+        return std::clamp(static_cast<int>(std::floor((x - origin.x) * inverseCellSize)), 0, columns - 1);
+    }
+    int cellY(float y) const {
+        return std::clamp(static_cast<int>(std::floor((y - origin.y) * inverseCellSize)), 0, rows - 1);
+    }
+
+    CellRange rangeOf(const sf::FloatRect& bounds) const {
+        return {cellX(bounds.position.x), cellY(bounds.position.y),
+                cellX(bounds.position.x + bounds.size.x), cellY(bounds.position.y + bounds.size.y)};
+    }
+
+    std::vector<Entry>& cellAt(int x, int y) { return cells[static_cast<std::size_t>(y) * columns + x]; }
+    const std::vector<Entry>& cellAt(int x, int y) const { return cells[static_cast<std::size_t>(y) * columns + x]; }
+
+    // Closed-interval overlap, so zero-sized bounds (points) are found too
+    static bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+        return a.position.x <= b.position.x + b.size.x && b.position.x <= a.position.x + a.size.x &&
+               a.position.y <= b.position.y + b.size.y && b.position.y <= a.position.y + a.size.y;
+    }
+
+public:
+    // Constructor - a single cell until reset() is given the real area
+    SpatialHash()
+        : cellSize(1.0f), inverseCellSize(1.0f), columns(1), rows(1), cells(1), objectCount(0) {}
+
+    // Drop everything and cover a new area
+    void reset(const sf::FloatRect& area, float newCellSize) {
+        origin = area.position;
+        cellSize = newCellSize > 0.0f ? newCellSize : 64.0f;
+        inverseCellSize = 1.0f / cellSize;
+        columns = std::max(1, static_cast<int>(std::ceil(area.size.x * inverseCellSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(area.size.y * inverseCellSize)));
+        cells.assign(static_cast<std::size_t>(columns) * rows, std::vector<Entry>());
+        objectCount = 0;
+    }
+
+    void clear() {
+        for (auto& cell : cells) cell.clear();
+        objectCount = 0;
+    }
+
+    void insert(T* object, const sf::FloatRect& bounds) {
+        CellRange range = rangeOf(bounds);
+        for (int y = range.minY; y <= range.maxY; y++) {
+            for (int x = range.minX; x <= range.maxX; x++) cellAt(x, y).push_back({object, bounds});
+        }
+        objectCount++;
+    }
+
+    // bounds must be the ones the object was inserted (or last updated) with
+    bool remove(T* object, const sf::FloatRect& bounds) {
+        CellRange range = rangeOf(bounds);
+        bool found = false;
+        for (int y = range.minY; y <= range.maxY; y++) {
+            for (int x = range.minX; x <= range.maxX; x++) {
+                auto& cell = cellAt(x, y);
+                for (std::size_t i = 0; i < cell.size(); i++) {
+                    if (cell[i].object == object) {
+                        cell[i] = cell.back();
+                        cell.pop_back();
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (found) objectCount--;
+        return found;
+    }
+
+    // Moving objects: only touches other cells when the covered range changes
+    void update(T* object, const sf::FloatRect& oldBounds, const sf::FloatRect& newBounds) {
+        CellRange oldRange = rangeOf(oldBounds);
+        CellRange newRange = rangeOf(newBounds);
+        if (!(oldRange == newRange)) {
+            remove(object, oldBounds);
+            insert(object, newBounds);
+            return;
+        }
+        for (int y = newRange.minY; y <= newRange.maxY; y++) {
+            for (int x = newRange.minX; x <= newRange.maxX; x++) {
+                for (Entry& entry : cellAt(x, y)) {
+                    if (entry.object == object) {
+                        entry.bounds = newBounds;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Visit every object whose bounds touch area, each exactly once
+    template <typename Visitor>
+    void query(const sf::FloatRect& area, Visitor&& visit) const {
+        CellRange range = rangeOf(area);
+        for (int y = range.minY; y <= range.maxY; y++) {
+            for (int x = range.minX; x <= range.maxX; x++) {
+                for (const Entry& entry : cellAt(x, y)) {
+                    if (!overlaps(entry.bounds, area)) continue;
+                    // An object spanning several cells is reported only from the
+                    // first cell it shares with the query
+                    if (x != std::max(cellX(entry.bounds.position.x), range.minX) ||
+                        y != std::max(cellY(entry.bounds.position.y), range.minY)) continue;
+                    visit(entry.object);
+                }
+            }
+        }
+    }
+
+    void query(const sf::FloatRect& area, std::vector<T*>& out) const {
+        out.clear();
+        query(area, [&out](T* object) { out.push_back(object); });
+    }
+
+    std::size_t size() const { return objectCount; }
+    float getCellSize() const { return cellSize; }
+};
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,141 @@
+/*
+ * Museum Escape - SpriteBatch Class Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+    sf::Vector2f computeNormal(const sf::Vector2f& p1, const sf::Vector2f& p2) {
+        sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0.0f) normal /= length;
+        return normal;
+    }
+}
+
+// Constructor
+SpriteBatch::SpriteBatch(const TextureAtlas* textureAtlas)
+    : vertices(sf::PrimitiveType::Triangles),
+      atlas(textureAtlas) {}
+
+void SpriteBatch::setAtlas(const TextureAtlas* textureAtlas) { atlas = textureAtlas; }
+const TextureAtlas* SpriteBatch::getAtlas() const { return atlas; }
+
+void SpriteBatch::clear() { vertices.clear(); }
+std::size_t SpriteBatch::getVertexCount() const { return vertices.getVertexCount(); }
+bool SpriteBatch::isEmpty() const { return vertices.getVertexCount() == 0; }
+
+void SpriteBatch::addTriangle(const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c) {
+    vertices.append(a);
+    vertices.append(b);
+    vertices.append(c);
+}
+
+// Sprite: one textured quad, texture coordinates remapped into the atlas
+void SpriteBatch::add(const sf::Sprite& sprite) {
+    if (!atlas) return;
+
+    sf::IntRect rect = sprite.getTextureRect();
+    sf::Transform transform = sprite.getTransform();
+    sf::Color color = sprite.getColor();
+
+    float width = static_cast<float>(std::abs(rect.size.x));
+    float height = static_cast<float>(std::abs(rect.size.y));
+
+    // Textures that were never packed fall back to a flat colored quad
+    float left, top, right, bottom;
+    if (atlas->contains(&sprite.getTexture())) {
+        sf::IntRect region = atlas->getRegion(&sprite.getTexture());
+        left = static_cast<float>(region.position.x + rect.position.x);
+        top = static_cast<float>(region.position.y + rect.position.y);
+        right = left + static_cast<float>(rect.size.x);
+        bottom = top + static_cast<float>(rect.size.y);
+    } else {
+        sf::Vector2f white = atlas->getWhiteTexCoords();
+        left = right = white.x;
+        top = bottom = white.y;
+    }
+
+    sf::Vertex topLeft{transform.transformPoint({0.0f, 0.0f}), color, {left, top}};
+    sf::Vertex topRight{transform.transformPoint({width, 0.0f}), color, {right, top}};
+    sf::Vertex bottomLeft{transform.transformPoint({0.0f, height}), color, {left, bottom}};
+    sf::Vertex bottomRight{transform.transformPoint({width, height}), color, {right, bottom}};
+
+    addTriangle(topLeft, topRight, bottomLeft);
+    addTriangle(bottomLeft, topRight, bottomRight);
+}
+
+// Shape: triangle fan for the fill plus a strip for the outline, both
+// sampling the atlas' white block so the vertex color is used as-is.
+// Mirrors the outline extrusion sf::Shape does internally.
+void SpriteBatch::add(const sf::Shape& shape) {
+    if (!atlas) return;
+
+    std::size_t count = shape.getPointCount();
+    if (count < 3) return;
+
+    sf::Transform transform = shape.getTransform();
+    sf::Vector2f white = atlas->getWhiteTexCoords();
+    sf::Vector2f center = shape.getGeometricCenter();
+
+    // Scratch buffers are members so steady-state batching doesn't allocate
+    std::vector<sf::Vector2f>& points = scratchPoints;
+    points.resize(count);
+    for (std::size_t i = 0; i < count; ++i) points[i] = shape.getPoint(i);
+
+    // Fill
+    sf::Color fill = shape.getFillColor();
+    if (fill.a > 0) {
+        sf::Vertex middle{transform.transformPoint(center), fill, white};
+        for (std::size_t i = 0; i < count; ++i) {
+            sf::Vertex a{transform.transformPoint(points[i]), fill, white};
+            sf::Vertex b{transform.transformPoint(points[(i + 1) % count]), fill, white};
+            addTriangle(middle, a, b);
+        }
+    }
+
+    // Outline
+    float thickness = shape.getOutlineThickness();
+    sf::Color outline = shape.getOutlineColor();
+    if (thickness == 0.0f || outline.a == 0) return;
+
+    std::vector<sf::Vector2f>& outer = scratchOuter;
+    outer.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const sf::Vector2f& p0 = points[(i + count - 1) % count];
+        const sf::Vector2f& p1 = points[i];
+        const sf::Vector2f& p2 = points[(i + 1) % count];
+
+        sf::Vector2f n1 = computeNormal(p0, p1);
+        sf::Vector2f n2 = computeNormal(p1, p2);
+
+        // Make sure that the normals point towards the outside of the shape
+        sf::Vector2f toCenter = center - p1;
+        if (n1.x * toCenter.x + n1.y * toCenter.y > 0) n1 = -n1;
+        if (n2.x * toCenter.x + n2.y * toCenter.y > 0) n2 = -n2;
+
+        float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+        sf::Vector2f normal = (n1 + n2) / factor;
+        outer[i] = p1 + normal * thickness;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t next = (i + 1) % count;
+        sf::Vertex innerA{transform.transformPoint(points[i]), outline, white};
+        sf::Vertex outerA{transform.transformPoint(outer[i]), outline, white};
+        sf::Vertex innerB{transform.transformPoint(points[next]), outline, white};
+        sf::Vertex outerB{transform.transformPoint(outer[next]), outline, white};
+        addTriangle(innerA, outerA, innerB);
+        addTriangle(innerB, outerA, outerB);
+    }
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!atlas || vertices.getVertexCount() == 0) return;
+    states.texture = &atlas->getTexture();
+    target.draw(vertices, states);
+}
@@ -0,0 +1,39 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class TextureAtlas;
+
+// SpriteBatch - Collects sprites and shapes that share the texture atlas
+// into one vertex array so a whole layer is submitted with one draw call.
+class SpriteBatch : public sf::Drawable {
+private:
+    sf::VertexArray vertices;
+    const TextureAtlas* atlas;
+    std::vector<sf::Vector2f> scratchPoints;
+    std::vector<sf::Vector2f> scratchOuter;
+
+    void addTriangle(const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c);
+
+public:
+    // Constructor
+    SpriteBatch(const TextureAtlas* textureAtlas = nullptr);
+
+    void setAtlas(const TextureAtlas* textureAtlas);
+    const TextureAtlas* getAtlas() const;
+
+    // Batch contents (clear() keeps the allocated capacity)
+    void clear();
+    void add(const sf::Sprite& sprite);
+    void add(const sf::Shape& shape);
+
+    std::size_t getVertexCount() const;
+    bool isEmpty() const;
+
+    // Rendering - one draw call for everything added since clear()
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+#endif // SPRITE_BATCH_H
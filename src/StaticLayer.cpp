@@ -0,0 +1,59 @@
+/*
+ * Museum Escape - Static Layer Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "StaticLayer.h"
+#include "Room.h"
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include <cmath>
+#include <iostream>
+
+StaticLayer::StaticLayer()
+    : sprite(layer.getTexture()),
+      cachedRoom(nullptr),
+      dirty(true),
+      usable(true),
+      rebuilds(0) {}
+
+void StaticLayer::invalidate() { dirty = true; }
+
+unsigned int StaticLayer::getRebuildCount() const { return rebuilds; }
+
+// The layer's view is the room itself, so the room draws in its own
+// coordinates. The batch is borrowed and left empty for the frame.
+bool StaticLayer::rebuild(Room& room, SpriteBatch& batch) {
+    PROFILE_SCOPE("StaticLayer::rebuild");
+    sf::FloatRect bounds = room.getBounds();
+    sf::Vector2u size(static_cast<unsigned int>(std::ceil(bounds.size.x)), static_cast<unsigned int>(std::ceil(bounds.size.y)));
+    if (layer.getSize() != size) {
+        if (!layer.resize(size)) {
+            std::cerr << "Error: Failed to create the static room layer; drawing rooms directly." << std::endl;
+            usable = false;
+            return false;
+        }
+        sprite.setTexture(layer.getTexture(), true);
+    }
+    layer.setView(sf::View(bounds));
+    layer.clear(sf::Color::Black);
+    batch.clear();
+    room.drawStatic(layer, batch);
+    if (batch.getAtlas()) layer.draw(batch);
+    batch.clear();
+    layer.display();
+
+    sprite.setPosition(bounds.position);
+    cachedRoom = &room;
+    dirty = false;
+    rebuilds++;
+    return true;
+}
+
+void StaticLayer::draw(sf::RenderTarget& target, Room& room, SpriteBatch& batch) {
+    if (!usable || ((dirty || cachedRoom != &room) && !rebuild(room, batch))) {
+        room.drawStatic(target, batch);
+        return;
+    }
+    target.draw(sprite);
+}
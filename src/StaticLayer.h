@@ -0,0 +1,40 @@
+#ifndef STATIC_LAYER_H
+#define STATIC_LAYER_H
+
+#include <SFML/Graphics.hpp>
+
+class Room;
+class SpriteBatch;
+
+// StaticLayer - The current room's unchanging scenery (Room::drawStatic)
+// rendered once into a texture and drawn as a single sprite each frame.
+// Redrawn only after invalidate() (a door unlocked or recolored, an item
+// collected, the background arrived) or when the room changes; guards,
+// the player and lighting are composited on top every frame.
+class StaticLayer {
+private:
+    sf::RenderTexture layer; // Room-sized
+    sf::Sprite sprite;
+    const Room* cachedRoom;  // Room the layer holds (identity only)
+    bool dirty;
+    bool usable;             // False once the texture could not be created
+    unsigned int rebuilds;
+
+    bool rebuild(Room& room, SpriteBatch& batch);
+
+public:
+    // Constructor - empty until the first draw
+    StaticLayer();
+
+    // Redraw the layer on the next draw
+    void invalidate();
+
+    // Call with the frame's batch still empty. Draws the layer to target,
+    // redrawing it first if needed; if no texture can be created, adds the
+    // scenery to batch (and target) like Room::drawStatic instead.
+    void draw(sf::RenderTarget& target, Room& room, SpriteBatch& batch);
+
+    unsigned int getRebuildCount() const;
+};
+
+#endif // STATIC_LAYER_H
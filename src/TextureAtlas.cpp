@@ -0,0 +1,107 @@
+/*
+ * Museum Escape - TextureAtlas Class Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+// Constructor
+TextureAtlas::TextureAtlas(unsigned int padding)
+    : padding(padding) {}
+
+void TextureAtlas::add(const sf::Texture& source, const sf::Image& image) {
+    pending.push_back({&source, image});
+}
+
+// Shelf packing: tallest images first, left to right, wrapping into new rows
+bool TextureAtlas::build() {
+    sf::Image white;
+    white.resize({8u, 8u}, sf::Color::White);
+
+    std::vector<std::pair<const sf::Texture*, const sf::Image*>> order;
+    for (const auto& entry : pending) order.push_back({entry.source, &entry.image});
+    order.push_back({nullptr, &white});
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        return a.second->getSize().y > b.second->getSize().y;
+    });
+
+    // Row width: widest image, but at least wide enough to avoid a single tall column
+    unsigned int maxSize = sf::Texture::getMaximumSize();
+    unsigned int rowWidth = 256;
+    unsigned int totalArea = 0;
+    for (const auto& item : order) {
+        sf::Vector2u size = item.second->getSize();
+        rowWidth = std::max(rowWidth, size.x + padding * 2);
+        totalArea += (size.x + padding * 2) * (size.y + padding * 2);
+    }
+    while (rowWidth * rowWidth < totalArea && rowWidth * 2 <= maxSize) rowWidth *= 2;
+
+    std::vector<sf::IntRect> placed;
+    unsigned int x = 0, y = 0, rowHeight = 0;
+    for (const auto& item : order) {
+        sf::Vector2u size = item.second->getSize();
+        unsigned int w = size.x + padding * 2;
+        unsigned int h = size.y + padding * 2;
+        if (x + w > rowWidth) {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        placed.push_back(sf::IntRect({static_cast<int>(x + padding), static_cast<int>(y + padding)},
+                                     {static_cast<int>(size.x), static_cast<int>(size.y)}));
+        x += w;
+        rowHeight = std::max(rowHeight, h);
+    }
+    unsigned int atlasHeight = y + rowHeight;
+
+    if (rowWidth > maxSize || atlasHeight > maxSize) {
+        std::cerr << "Error: Texture atlas (" << rowWidth << "x" << atlasHeight
+                  << ") exceeds maximum texture size." << std::endl;
+        return false;
+    }
+
+    sf::Image atlasImage;
+    atlasImage.resize({rowWidth, atlasHeight}, sf::Color::Transparent);
+    regions.clear();
+    for (size_t i = 0; i < order.size(); ++i) {
+        sf::Vector2u dest(static_cast<unsigned int>(placed[i].position.x),
+                          static_cast<unsigned int>(placed[i].position.y));
+        if (!atlasImage.copy(*order[i].second, dest)) {
+            std::cerr << "Error: Failed to copy image into texture atlas." << std::endl;
+            return false;
+        }
+        if (order[i].first) regions[order[i].first] = placed[i];
+        else whiteRegion = placed[i];
+    }
+
+    if (!texture.loadFromImage(atlasImage)) {
+        std::cerr << "Error: Failed to upload texture atlas." << std::endl;
+        return false;
+    }
+    texture.setSmooth(true);
+    if (!texture.generateMipmap()) {
+        std::cout << "Warning: Texture atlas has no mipmaps." << std::endl;
+    }
+    pending.clear();
+    return true;
+}
+
+const sf::Texture& TextureAtlas::getTexture() const { return texture; }
+
+bool TextureAtlas::contains(const sf::Texture* source) const {
+    return regions.find(source) != regions.end();
+}
+
+sf::IntRect TextureAtlas::getRegion(const sf::Texture* source) const {
+    auto it = regions.find(source);
+    if (it != regions.end()) return it->second;
+    return whiteRegion;
+}
+
+// Sample the middle of the white block so filtering never reaches its edges
+sf::Vector2f TextureAtlas::getWhiteTexCoords() const {
+    return {whiteRegion.position.x + whiteRegion.size.x / 2.0f,
+            whiteRegion.position.y + whiteRegion.size.y / 2.0f};
+}
@@ -0,0 +1,38 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+
+// TextureAtlas - Packs several source images into one texture so that
+// everything using them can be drawn with a single texture bind.
+class TextureAtlas {
+private:
+    struct Entry {
+        const sf::Texture* source;
+        sf::Image image;
+    };
+
+    std::vector<Entry> pending; // Images waiting for build()
+    std::unordered_map<const sf::Texture*, sf::IntRect> regions;
+    sf::Texture texture;
+    sf::IntRect whiteRegion; // Solid white block used by untextured shapes
+    unsigned int padding;
+
+public:
+    // Constructor
+    TextureAtlas(unsigned int padding = 4);
+
+    // Register the image backing a texture; call build() once all are added
+    void add(const sf::Texture& source, const sf::Image& image);
+    bool build();
+
+    // Lookups
+    const sf::Texture& getTexture() const;
+    bool contains(const sf::Texture* source) const;
+    sf::IntRect getRegion(const sf::Texture* source) const; // Falls back to the white block
+    sf::Vector2f getWhiteTexCoords() const;
+};
+
+#endif // TEXTURE_ATLAS_H
@@ -4,8 +4,6 @@
  */
 
 #include "Timer.h"
-#include <sstream>
-#include <iomanip>
 
 // Constructor
 Timer::Timer(float totalSeconds)
@@ -19,8 +17,10 @@ Timer::Timer(float totalSeconds)
       warningThreshold(60.0f),
       criticalThreshold(30.0f),
       displayPosition(10.0f, 10.0f),
-      timerText(defaultFont),
-      background({200.0f, 50.0f})
+      timerText(placeholderFont()),
+      background({200.0f, 50.0f}),
+      formattedSeconds(-1),
+      textSeconds(-1)
 {
     // Setup background
     background.setFillColor(sf::Color(0, 0, 0, 150));
@@ -89,8 +89,11 @@ void Timer::update(float deltaTime) {
         timerText.setFillColor(normalColor);
     }
     
-    // Update text
-    timerText.setString("Time: " + getFormattedTime());
+    // Update text (only when the displayed second changes)
+    if (static_cast<int>(remainingTime) != textSeconds) {
+        textSeconds = static_cast<int>(remainingTime);
+        timerText.setString("Time: " + getFormattedTime());
+    }
 }
 
 // Add time (bonus)
@@ -132,15 +135,23 @@ bool Timer::isExpired() const {
 }
 
 // Get formatted time string (MM:SS)
-std::string Timer::getFormattedTime() const {
-    int minutes = static_cast<int>(remainingTime) / 60;
-    int seconds = static_cast<int>(remainingTime) % 60;
+const std::string& Timer::getFormattedTime() const {
+    int totalSeconds = static_cast<int>(remainingTime);
+    if (totalSeconds == formattedSeconds) return formattedTime;
+    formattedSeconds = totalSeconds;
+    
+    int minutes = totalSeconds / 60;
+    int seconds = totalSeconds % 60;
     
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << minutes << ":"
-        << std::setfill('0') << std::setw(2) << seconds;
+    // Two-digit minimum for both fields, no stream needed
+    formattedTime.clear();
+    if (minutes < 10) formattedTime += '0';
+    formattedTime += std::to_string(minutes);
+    formattedTime += ':';
+    formattedTime += static_cast<char>('0' + seconds / 10);
+    formattedTime += static_cast<char>('0' + seconds % 10);
     
-    return oss.str();
+    return formattedTime;
 }
 
 // Set display position
@@ -151,8 +162,9 @@ void Timer::setDisplayPosition(float x, float y) {
 }
 
 // Set font
-void Timer::setFont(const sf::Font& f) {
-    timerText.setFont(f);
+void Timer::setFont(FontHandle f) {
+    font = f;
+    if (font) timerText.setFont(*font);
 }
 
 // Set warning threshold
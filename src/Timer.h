@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include "ResourceCache.h"
 
 class Timer {
 private:
@@ -12,12 +13,16 @@ private:
     bool hasExpired;
     
     // Display
-    sf::Font defaultFont; // Default font for initialization
-    sf::Font font;
+    FontHandle font; // Shared from the ResourceCache
     sf::Text timerText;
     sf::RectangleShape background;
     sf::Vector2f displayPosition;
     
+    // "MM:SS" is only rebuilt when the whole second changes
+    mutable int formattedSeconds;
+    mutable std::string formattedTime;
+    int textSeconds; // Second currently shown by timerText
+    
     // Warning colors
     sf::Color normalColor;
     sf::Color warningColor; // When time is low
@@ -48,9 +53,9 @@ public:
     bool isExpired() const;
     
     // Display formatting
-    std::string getFormattedTime() const; // Returns "MM:SS" format
+    const std::string& getFormattedTime() const; // Returns "MM:SS" format
     void setDisplayPosition(float x, float y);
-    void setFont(const sf::Font& f);
+    void setFont(FontHandle f);
     
     // Thresholds
     void setWarningThreshold(float seconds);
@@ -0,0 +1,197 @@
+/*
+ * Museum Escape - Retained UI Widgets Implementation
+ * CS/CE 224/272 - Fall 2025
+ */
+
+#include "Widgets.h"
+
+namespace {
+    void appendQuad(sf::VertexArray& vertices, sf::Vector2f topLeft, sf::Vector2f bottomRight, const sf::Color& color) {
+        sf::Vertex a{topLeft, color};
+        sf::Vertex b{{bottomRight.x, topLeft.y}, color};
+        sf::Vertex c{{topLeft.x, bottomRight.y}, color};
+        sf::Vertex d{bottomRight, color};
+        vertices.append(a);
+        vertices.append(b);
+        vertices.append(c);
+        vertices.append(c);
+        vertices.append(b);
+        vertices.append(d);
+    }
+}
+
+// ============================================================================
+// Panel
+// ============================================================================
+
+Panel::Panel(UiScreen* screen, const sf::Vector2f& pos, const sf::Vector2f& panelSize,
+             const sf::Color& fill, float thickness, const sf::Color& outline)
+    : owner(screen),
+      position(pos),
+      size(panelSize),
+      fillColor(fill),
+      outlineColor(outline),
+      outlineThickness(thickness) {}
+
+void Panel::setFillColor(const sf::Color& color) {
+    if (fillColor == color) return;
+    fillColor = color;
+    if (owner) owner->markDirty();
+}
+
+void Panel::setOutline(float thickness, const sf::Color& color) {
+    if (outlineThickness == thickness && outlineColor == color) return;
+    outlineThickness = thickness;
+    outlineColor = color;
+    if (owner) owner->markDirty();
+}
+
+sf::FloatRect Panel::getBounds() const { return sf::FloatRect(position, size); }
+bool Panel::contains(const sf::Vector2f& point) const { return getBounds().contains(point); }
+
+// Fill plus an outline growing outwards, like sf::RectangleShape
+void Panel::appendTo(sf::VertexArray& vertices) const {
+    sf::Vector2f end = position + size;
+    if (fillColor.a > 0) appendQuad(vertices, position, end, fillColor);
+
+    float t = outlineThickness;
+    if (t <= 0.0f || outlineColor.a == 0) return;
+    appendQuad(vertices, {position.x - t, position.y - t}, {end.x + t, position.y}, outlineColor);
+    appendQuad(vertices, {position.x - t, end.y}, {end.x + t, end.y + t}, outlineColor);
+    appendQuad(vertices, {position.x - t, position.y}, {position.x, end.y}, outlineColor);
+    appendQuad(vertices, {end.x, position.y}, {end.x + t, end.y}, outlineColor);
+}
+
+// ============================================================================
+// Button
+// ============================================================================
+
+Button::Button(UiScreen* screen, int buttonId, const sf::Vector2f& pos, const sf::Vector2f& size,
+               const sf::Color& fill, const sf::Font& font, const std::string& text, unsigned int characterSize)
+    : panel(screen, pos, size, fill, 2.0f, sf::Color::White),
+      caption(font, characterSize, sf::Color::White),
+      id(buttonId)
+{
+    caption.setString(text);
+    // Center the caption; glyphs sit roughly 0.65 em below the text origin
+    caption.setPosition({pos.x + size.x / 2.0f, pos.y + size.y / 2.0f - characterSize * 0.65f}, TextAlign::CENTER);
+}
+
+int Button::getId() const { return id; }
+Panel& Button::getPanel() { return panel; }
+const Panel& Button::getPanel() const { return panel; }
+const Label& Button::getCaption() const { return caption; }
+bool Button::contains(const sf::Vector2f& point) const { return panel.contains(point); }
+
+// ============================================================================
+// TextInput
+// ============================================================================
+
+TextInput::TextInput(UiScreen* screen, const sf::Vector2f& pos, const sf::Vector2f& size,
+                     const sf::Font& font, unsigned int characterSize, std::size_t maxChars)
+    : box(screen, pos, size, sf::Color(20, 20, 30), 2.0f, sf::Color::White),
+      text(font, characterSize, sf::Color::White),
+      maxLength(maxChars)
+{
+    text.setPosition({pos.x + 10.0f, pos.y + 7.0f});
+    text.setString("_"); // Cursor
+}
+
+const std::string& TextInput::getValue() const { return value; }
+
+void TextInput::setValue(const std::string& str) {
+    if (str == value) return;
+    value = str.substr(0, maxLength);
+    text.setString(value + "_");
+}
+
+bool TextInput::append(char c) {
+    if (value.length() >= maxLength) return false;
+    value += c;
+    text.setString(value + "_");
+    return true;
+}
+
+bool TextInput::backspace() {
+    if (value.empty()) return false;
+    value.pop_back();
+    text.setString(value + "_");
+    return true;
+}
+
+const Panel& TextInput::getBox() const { return box; }
+const Label& TextInput::getText() const { return text; }
+
+// ============================================================================
+// UiScreen
+// ============================================================================
+
+UiScreen::UiScreen()
+    : geometry(sf::PrimitiveType::Triangles),
+      dirty(true) {}
+
+Panel& UiScreen::addPanel(const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& fill,
+                          float outlineThickness, const sf::Color& outline) {
+    panels.push_back(std::make_unique<Panel>(this, pos, size, fill, outlineThickness, outline));
+    markDirty();
+    return *panels.back();
+}
+
+Label& UiScreen::addLabel(const sf::Font& font, const std::string& text, unsigned int characterSize,
+                          const sf::Color& color, const sf::Vector2f& pos, TextAlign align) {
+    labels.push_back(std::make_unique<Label>(font, characterSize, color));
+    Label& label = *labels.back();
+    label.setString(text);
+    label.setPosition(pos, align);
+    return label;
+}
+
+Button& UiScreen::addButton(int id, const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& fill,
+                            const sf::Font& font, const std::string& text, unsigned int characterSize) {
+    buttons.push_back(std::make_unique<Button>(this, id, pos, size, fill, font, text, characterSize));
+    markDirty();
+    return *buttons.back();
+}
+
+TextInput& UiScreen::addTextInput(const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Font& font,
+                                  unsigned int characterSize, std::size_t maxChars) {
+    inputs.push_back(std::make_unique<TextInput>(this, pos, size, font, characterSize, maxChars));
+    markDirty();
+    return *inputs.back();
+}
+
+void UiScreen::clear() {
+    panels.clear();
+    buttons.clear();
+    inputs.clear();
+    labels.clear();
+    markDirty();
+}
+
+bool UiScreen::isEmpty() const {
+    return panels.empty() && buttons.empty() && inputs.empty() && labels.empty();
+}
+
+const Button* UiScreen::buttonAt(const sf::Vector2f& point) const {
+    for (auto it = buttons.rbegin(); it != buttons.rend(); ++it) {
+        if ((*it)->contains(point)) return it->get();
+    }
+    return nullptr;
+}
+
+void UiScreen::markDirty() { dirty = true; }
+
+void UiScreen::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (dirty) {
+        geometry.clear();
+        for (const auto& panel : panels) panel->appendTo(geometry);
+        for (const auto& button : buttons) button->getPanel().appendTo(geometry);
+        for (const auto& input : inputs) input->getBox().appendTo(geometry);
+        dirty = false;
+    }
+
+    target.draw(geometry, states);
+    for (const auto& label : labels) target.draw(*label, states);
+    for (const auto& button : buttons) target.draw(button->getCaption(), states);
+    for (const auto& input : inputs) target.draw(input->getText(), states);
+}
@@ -0,0 +1,116 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Label.h"
+
+class UiScreen;
+
+// Panel - Filled, outlined rectangle. Holds no SFML shape of its own; its
+// geometry lives in the owning screen's cached vertex array.
+class Panel {
+private:
+    UiScreen* owner;
+    sf::Vector2f position;
+    sf::Vector2f size;
+    sf::Color fillColor;
+    sf::Color outlineColor;
+    float outlineThickness;
+
+public:
+    Panel(UiScreen* screen, const sf::Vector2f& pos, const sf::Vector2f& panelSize,
+          const sf::Color& fill, float thickness = 0.0f, const sf::Color& outline = sf::Color::White);
+
+    void setFillColor(const sf::Color& color);
+    void setOutline(float thickness, const sf::Color& color);
+
+    sf::FloatRect getBounds() const;
+    bool contains(const sf::Vector2f& point) const;
+
+    void appendTo(sf::VertexArray& vertices) const;
+};
+
+// Button - Panel with a centered caption and an id for hit testing
+class Button {
+private:
+    Panel panel;
+    Label caption;
+    int id;
+
+public:
+    Button(UiScreen* screen, int buttonId, const sf::Vector2f& pos, const sf::Vector2f& size,
+           const sf::Color& fill, const sf::Font& font, const std::string& text, unsigned int characterSize);
+
+    int getId() const;
+    Panel& getPanel();
+    const Panel& getPanel() const;
+    const Label& getCaption() const;
+    bool contains(const sf::Vector2f& point) const;
+};
+
+// TextInput - Boxed single line of editable text with a cursor
+class TextInput {
+private:
+    Panel box;
+    Label text;
+    std::string value;
+    std::size_t maxLength;
+
+public:
+    TextInput(UiScreen* screen, const sf::Vector2f& pos, const sf::Vector2f& size,
+              const sf::Font& font, unsigned int characterSize, std::size_t maxChars);
+
+    const std::string& getValue() const;
+    void setValue(const std::string& str);
+    bool append(char c);
+    bool backspace();
+
+    const Panel& getBox() const;
+    const Label& getText() const;
+};
+
+// UiScreen - Owns a set of widgets. All rectangles are cached in a single
+// vertex array that is only rebuilt when a widget reports a change; labels
+// keep their own glyph geometry. A screen nobody touches costs one vertex
+// array draw plus one draw per label.
+class UiScreen : public sf::Drawable {
+private:
+    std::vector<std::unique_ptr<Panel>> panels;
+    std::vector<std::unique_ptr<Button>> buttons;
+    std::vector<std::unique_ptr<TextInput>> inputs;
+    std::vector<std::unique_ptr<Label>> labels;
+
+    mutable sf::VertexArray geometry;
+    mutable bool dirty;
+
+public:
+    // Constructor
+    UiScreen();
+
+    // Widgets are heap-allocated so references stay valid as more are added
+    Panel& addPanel(const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& fill,
+                    float outlineThickness = 0.0f, const sf::Color& outline = sf::Color::White);
+    Label& addLabel(const sf::Font& font, const std::string& text, unsigned int characterSize,
+                    const sf::Color& color, const sf::Vector2f& pos, TextAlign align = TextAlign::LEFT);
+    Button& addButton(int id, const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Color& fill,
+                      const sf::Font& font, const std::string& text, unsigned int characterSize);
+    TextInput& addTextInput(const sf::Vector2f& pos, const sf::Vector2f& size, const sf::Font& font,
+                            unsigned int characterSize, std::size_t maxChars);
+
+    void clear();
+    bool isEmpty() const;
+
+    // Topmost button under a point, or nullptr
+    const Button* buttonAt(const sf::Vector2f& point) const;
+
+    // Called by widgets whose geometry changed
+    void markDirty();
+
+    // Rendering
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+#endif // WIDGETS_H
@@ -2,24 +2,107 @@
  * Museum Escape - Main Entry Point
  * CS/CE 224/272 - Fall 2025
  * Team: Hamza Sami & Mohammad Yousuf Lali
+ *
+ * Usage:
+ *     main                                  play in a window
+ *     main --record <log>                   play and record input to <log>
+ *     main --replay <log>                   watch a recorded session
+ *     main --headless [ticks]               step a scripted session without a
+ *                                           window and report throughput
+ *                                           (default 1000000 ticks)
+ *     main --headless [ticks] --record <log>   ...and record its input
+ *     main --headless --replay <log>        replay as fast as possible and
+ *                                           check the final state
+ *     main --level <file> ...               any of the above on another level
+ *                                           (.level text or compiled .melv);
+ *                                           replays need the level they were
+ *                                           recorded on
  */
 
+#include <cctype>
 #include <iostream>
+#include <string>
 #include "Game.h"
+#include "HeadlessRunner.h"
 
-int main() {
+static void printReport(const HeadlessRunner::Report& report) {
+    std::cout << "Headless: " << report.ticks << " ticks in " << report.seconds << " s"
+              << " (" << static_cast<unsigned long long>(report.ticksPerSecond()) << " ticks/s)" << std::endl;
+    std::cout << "Sessions: " << report.sessions << " (" << report.victories << " escaped, "
+              << report.gameOvers << " caught or timed out)" << std::endl;
+}
+
+static int runHeadless(unsigned long long ticks, const std::string& levelPath, const std::string& recordPath, const std::string& replayPath) {
+    HeadlessRunner runner;
+    if (!levelPath.empty() && !runner.getSimulation().loadLevel(levelPath)) return EXIT_FAILURE;
+
+    if (!replayPath.empty()) {
+        InputReplay log;
+        if (!log.load(replayPath)) return EXIT_FAILURE;
+        HeadlessRunner::Report report = runner.replay(log);
+        printReport(report);
+
+        std::uint64_t expected = log.getHeader().checksum;
+        if (expected == 0) {
+            std::cout << "Replay: log has no checksum, state not verified" << std::endl;
+            return EXIT_SUCCESS;
+        }
+        bool match = report.checksum == expected;
+        std::cout << "Replay: " << (match ? "state matches recording" : "STATE DIVERGED from recording") << std::endl;
+        return match ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    InputRecorder recorder;
+    if (!recordPath.empty()) {
+        std::uint32_t seed = runner.getSimulation().getSeed();
+        if (!recorder.open(recordPath, runner.getSimulationStep(), seed, LOG_AUTO_RESTART)) return EXIT_FAILURE;
+    }
+    printReport(runner.run(ticks, recorder.isOpen() ? &recorder : nullptr));
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[]) {
     try {
+        bool headless = false;
+        unsigned long long ticks = 1000000ULL;
+        std::string levelPath, recordPath, replayPath;
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--headless") {
+                headless = true;
+                if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) ticks = std::stoull(argv[++i]);
+            } else if (arg == "--level" && i + 1 < argc) {
+                levelPath = argv[++i];
+            } else if (arg == "--record" && i + 1 < argc) {
+                recordPath = argv[++i];
+            } else if (arg == "--replay" && i + 1 < argc) {
+                replayPath = argv[++i];
+            } else {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        if (!recordPath.empty() && !replayPath.empty()) {
+            std::cerr << "Error: --record and --replay cannot be combined." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (headless) return runHeadless(ticks, levelPath, recordPath, replayPath);
+
         // Create game instance
         Game game;
-        
+        if (!levelPath.empty() && !game.loadLevel(levelPath)) return EXIT_FAILURE;
+        if (!recordPath.empty() && !game.startRecording(recordPath)) return EXIT_FAILURE;
+        if (!replayPath.empty() && !game.startReplay(replayPath)) return EXIT_FAILURE;
+
         // Run the game loop
         game.run();
-        
+
     } catch (const std::exception& e) {
         // Catch any errors and display them
         std::cerr << "Error: " << e.what() << std::endl;
         return EXIT_FAILURE;
     }
-    
+
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,123 @@
+/*
+ * Museum Escape - Asset Loading Benchmark
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Times a cold start of every asset in an archive, once from the loose
+ * files and once from the archive (open, map, decode):
+ *
+ *     AssetBench [archive] [runs]      (default: assets/assets.pak 5)
+ *
+ * "Cold" means evicted from the OS page cache before each run. On Linux
+ * that is done per file with posix_fadvise; elsewhere the runs after the
+ * first are warm, so flush the cache by hand (or reboot) between runs.
+ * Build together with ../AssetArchive.cpp and ../MappedFile.cpp and link
+ * sfml-graphics and sfml-audio.
+ */
+
+#include "../AssetArchive.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Drop a file's pages so the next read goes to disk
+    bool evictFromCache(const std::string& path) {
+#ifdef __linux__
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        bool evicted = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        ::close(fd);
+        return evicted;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // Decode the asset the way the game would: fonts and images fully,
+    // anything else (levels, sounds) is just read
+    bool decode(const AssetArchive& archive, const std::string& name) {
+        if (endsWith(name, ".ttf")) {
+            sf::Font font;
+            return archive.load(font, name);
+        }
+        if (endsWith(name, ".png") || endsWith(name, ".jpg")) {
+            sf::Image image;
+            return archive.load(image, name);
+        }
+
+        AssetArchive::Span span = archive.find(name);
+        if (span.data) {
+            unsigned checksum = 0;
+            for (std::size_t i = 0; i < span.size; i += 4096) checksum += span.data[i];
+            return checksum != 0xFFFFFFFFu;
+        }
+        std::ifstream file(name, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return static_cast<bool>(file) || file.eof();
+    }
+
+    double timeRun(const std::string& archivePath, const std::vector<std::string>& names, bool packed, bool& ok) {
+        for (const std::string& name : names) evictFromCache(name);
+        evictFromCache(archivePath);
+
+        auto start = BenchClock::now();
+        AssetArchive archive;
+        if (packed && !archive.open(archivePath)) ok = false;
+        for (const std::string& name : names) {
+            if (!decode(archive, name)) {
+                std::cerr << "Error: Could not load " << name << (packed ? " from the archive" : "") << std::endl;
+                ok = false;
+            }
+        }
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string archivePath = argc > 1 ? argv[1] : AssetArchive::DEFAULT_PATH;
+    int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    // The archive's table of contents is the asset list for both sides
+    std::vector<std::string> names;
+    {
+        AssetArchive archive;
+        if (!archive.open(archivePath)) return EXIT_FAILURE;
+        names = archive.getEntryNames();
+    }
+    bool cold = evictFromCache(archivePath);
+    std::cout << archivePath << ": " << names.size() << " assets, " << runs << " runs, "
+              << (cold ? "page cache evicted before each run" : "page cache NOT evicted (warm after run 1)") << std::endl;
+
+    bool ok = true;
+    double looseTotal = 0.0, packedTotal = 0.0;
+    for (int i = 0; i < runs; i++) {
+        // Alternate which goes first so neither side always runs right
+        // after the other's I/O
+        if (i % 2 == 0) {
+            looseTotal += timeRun(archivePath, names, false, ok);
+            packedTotal += timeRun(archivePath, names, true, ok);
+        } else {
+            packedTotal += timeRun(archivePath, names, true, ok);
+            looseTotal += timeRun(archivePath, names, false, ok);
+        }
+    }
+    std::cout << "  loose files:  " << looseTotal / runs << " ms" << std::endl;
+    std::cout << "  archive:      " << packedTotal / runs << " ms" << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
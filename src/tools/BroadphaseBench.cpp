@@ -0,0 +1,123 @@
+/*
+ * Museum Escape - Broadphase Microbenchmark
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Compares the room's spatial-hash queries against the linear scans they
+ * replaced, on a generated room full of pickups, doors and guards:
+ *
+ *     BroadphaseBench [items] [guards] [queries]   (default 500 60 200000)
+ *
+ * Build together with the game sources except main.cpp and link
+ * sfml-graphics.
+ */
+
+#include "../Room.h"
+#include "../Guard.h"
+#include "../Item.h"
+#include "../AssetCooker.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    const float ROOM_WIDTH = 3200.0f;
+    const float ROOM_HEIGHT = 2400.0f;
+    const int DOOR_COUNT = 24;
+
+    using BenchClock = std::chrono::steady_clock;
+
+    double nanosecondsPer(BenchClock::time_point start, BenchClock::time_point end, std::size_t count) {
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(count);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int itemCount = argc > 1 ? std::atoi(argv[1]) : 500;
+    int guardCount = argc > 2 ? std::atoi(argv[2]) : 60;
+    std::size_t queryCount = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 200000;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> randomX(0.0f, ROOM_WIDTH);
+    std::uniform_real_distribution<float> randomY(0.0f, ROOM_HEIGHT);
+    std::uniform_real_distribution<float> randomRadius(80.0f, 120.0f);
+
+    sf::Texture emptyTexture;
+    Room room(1, "Bench Hall", 0.0f, 0.0f, ROOM_WIDTH, ROOM_HEIGHT, "");
+    for (int i = 0; i < itemCount; i++) {
+        room.addItem(std::make_shared<Key>("Key " + std::to_string(i), "", randomX(rng), randomY(rng)));
+    }
+    for (int i = 0; i < DOOR_COUNT; i++) {
+        room.addDoor(std::make_shared<Door>(randomX(rng), randomY(rng), 1));
+    }
+    for (int i = 0; i < guardCount; i++) {
+        auto guard = std::make_shared<Guard>(randomX(rng), randomY(rng), randomRadius(rng), emptyTexture);
+        guard->addPatrolPoint(randomX(rng), randomY(rng));
+        guard->addPatrolPoint(randomX(rng), randomY(rng));
+        room.addGuard(guard);
+    }
+
+    // Player probes: a character-sized box at random spots
+    std::vector<sf::FloatRect> probes(queryCount);
+    for (auto& probe : probes) probe = sf::FloatRect({randomX(rng), randomY(rng)}, CHARACTER_DISPLAY_SIZE);
+
+    // Linear scans, as the simulation did them before the index
+    std::size_t linearHits = 0;
+    auto linearStart = BenchClock::now();
+    for (const sf::FloatRect& probe : probes) {
+        for (auto& door : room.getDoors()) if (door->checkCollision(probe)) linearHits++;
+        for (auto& item : room.getItems()) if (item->checkCollision(probe)) linearHits++;
+        for (auto& guard : room.getGuards()) {
+            sf::Vector2f d = guard->getPosition() - probe.position;
+            if (std::sqrt(d.x * d.x + d.y * d.y) < guard->getDetectionRadius()) linearHits++;
+        }
+    }
+    auto linearEnd = BenchClock::now();
+
+    // Broadphase queries followed by the same exact tests
+    std::vector<Door*> doors;
+    std::vector<Item*> items;
+    std::vector<Guard*> guards;
+    std::size_t indexedHits = 0;
+    auto indexedStart = BenchClock::now();
+    for (const sf::FloatRect& probe : probes) {
+        room.findDoors(probe, doors);
+        for (Door* door : doors) if (door->checkCollision(probe)) indexedHits++;
+        room.findItems(probe, items);
+        for (Item* item : items) if (item->checkCollision(probe)) indexedHits++;
+        room.findGuardsNear(probe.position, room.getMaxDetectionRadius(), guards);
+        for (Guard* guard : guards) {
+            sf::Vector2f d = guard->getPosition() - probe.position;
+            float radius = guard->getDetectionRadius();
+            if (d.x * d.x + d.y * d.y < radius * radius) indexedHits++;
+        }
+    }
+    auto indexedEnd = BenchClock::now();
+
+    // Cost of keeping the index current while guards patrol
+    const int patrolTicks = 1000;
+    auto patrolStart = BenchClock::now();
+    for (int tick = 0; tick < patrolTicks; tick++) {
+        for (auto& guard : room.getGuards()) guard->patrol(1.0f / 120.0f);
+    }
+    auto patrolEnd = BenchClock::now();
+
+    std::cout << "Room: " << itemCount << " items, " << DOOR_COUNT << " doors, " << guardCount << " guards, "
+              << queryCount << " queries" << std::endl;
+    std::cout << "Linear scan:  " << nanosecondsPer(linearStart, linearEnd, queryCount) << " ns/query ("
+              << linearHits << " hits)" << std::endl;
+    std::cout << "Spatial hash: " << nanosecondsPer(indexedStart, indexedEnd, queryCount) << " ns/query ("
+              << indexedHits << " hits)" << std::endl;
+    std::cout << "Guard patrol + index update: "
+              << nanosecondsPer(patrolStart, patrolEnd, static_cast<std::size_t>(patrolTicks) * guardCount)
+              << " ns/guard/tick" << std::endl;
+
+    if (linearHits != indexedHits) {
+        std::cerr << "Mismatch: the index missed or duplicated results" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,29 @@
+/*
+ * Museum Escape - Asset Cooking Tool
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Pre-scales the character art into assets/cooked/ so the game never has
+ * to load or sample the full-size sources. Run as a build step:
+ *
+ *     CookAssets [assetsDir]      (default: assets)
+ *
+ * Build together with ../AssetCooker.cpp and link sfml-graphics.
+ */
+
+#include "../AssetCooker.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string assetsDir = argc > 1 ? argv[1] : "assets";
+    sf::Vector2u size = AssetCooker::cookedCharacterSize();
+
+    const char* sprites[] = {"player.png", "guard.png"};
+    int failures = 0;
+    for (const char* name : sprites) {
+        if (!AssetCooker::cook(assetsDir + "/" + name, assetsDir + "/cooked/" + name, size)) failures++;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
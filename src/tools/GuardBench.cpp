@@ -0,0 +1,113 @@
+/*
+ * Museum Escape - GuardSystem Benchmark
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Times the batch patrol and detection kernels on a large generated guard
+ * population, once per kernel this build supports, and checks that every
+ * kernel ends in bit-identical state:
+ *
+ *     GuardBench [guards] [ticks]      (default 100000 600)
+ *
+ * Build together with ../GuardSystem.cpp, ../PathService.cpp,
+ * ../NavGrid.cpp, ../FlowField.cpp and ../Profiler.cpp (header-only SFML
+ * use). Compile with AVX enabled (-mavx, /arch:AVX) to include the 8-lane
+ * kernel.
+ */
+
+#include "../GuardSystem.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    void populate(GuardSystem& guards, std::size_t count) {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> coordinate(0.0f, 4000.0f);
+        std::uniform_real_distribution<float> radius(80.0f, 120.0f);
+        std::uniform_int_distribution<int> pointCount(2, 4);
+
+        guards.clear();
+        guards.reserve(count);
+        std::vector<sf::Vector2f> route;
+        for (std::size_t i = 0; i < count; i++) {
+            std::size_t slot = guards.add({coordinate(rng), coordinate(rng)}, 80.0f, radius(rng), 2.0f);
+            route.clear();
+            int points = pointCount(rng);
+            for (int p = 0; p < points; p++) route.push_back({coordinate(rng), coordinate(rng)});
+            guards.setPatrol(slot, route);
+        }
+    }
+
+    struct Result {
+        double updateMs;
+        double detectMs;
+        std::size_t detections;
+        std::vector<sf::Vector2f> finalPositions;
+    };
+
+    Result runKernel(GuardSystem::Kernel kernel, std::size_t count, int ticks) {
+        GuardSystem guards;
+        guards.setKernel(kernel);
+        populate(guards, count);
+
+        const float dt = 1.0f / 120.0f;
+        std::vector<std::size_t> hits;
+        Result result{0.0, 0.0, 0, {}};
+        double updateTotal = 0.0, detectTotal = 0.0;
+        sf::Vector2f player(2000.0f, 2000.0f);
+
+        for (int tick = 0; tick < ticks; tick++) {
+            auto start = BenchClock::now();
+            guards.savePreviousPositions();
+            guards.update(dt);
+            auto middle = BenchClock::now();
+            guards.detect(player, hits);
+            auto end = BenchClock::now();
+
+            updateTotal += std::chrono::duration<double, std::milli>(middle - start).count();
+            detectTotal += std::chrono::duration<double, std::milli>(end - middle).count();
+            result.detections += hits.size();
+            player.x += 1.0f; // Sweep the player across the crowd
+        }
+
+        result.updateMs = updateTotal / ticks;
+        result.detectMs = detectTotal / ticks;
+        for (std::size_t i = 0; i < guards.size(); i++) result.finalPositions.push_back(guards.getPosition(i));
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int ticks = argc > 2 ? std::atoi(argv[2]) : 600;
+
+    std::cout << count << " guards, " << ticks << " ticks" << std::endl;
+
+    const GuardSystem::Kernel kernels[] = {GuardSystem::Kernel::SCALAR, GuardSystem::Kernel::SSE, GuardSystem::Kernel::AVX};
+    std::vector<sf::Vector2f> reference;
+    std::size_t referenceDetections = 0;
+    bool identical = true;
+
+    for (GuardSystem::Kernel kernel : kernels) {
+        if (kernel > GuardSystem::bestKernel()) break;
+        Result result = runKernel(kernel, count, ticks);
+        std::cout << GuardSystem::kernelName(kernel) << ": update " << result.updateMs << " ms, detect "
+                  << result.detectMs << " ms per tick (" << result.detections << " detections)" << std::endl;
+
+        if (reference.empty()) {
+            reference = result.finalPositions;
+            referenceDetections = result.detections;
+        } else if (result.detections != referenceDetections ||
+                   std::memcmp(reference.data(), result.finalPositions.data(), reference.size() * sizeof(sf::Vector2f)) != 0) {
+            identical = false;
+        }
+    }
+
+    std::cout << (identical ? "All kernels bit-identical" : "MISMATCH between kernels") << std::endl;
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,171 @@
+/*
+ * Museum Escape - Level Compiler
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Compiles a .level text file into the flat binary form the game maps at
+ * load time, generates large grid maps for testing, and times loading:
+ *
+ *     LevelCompiler <in.level> <out.melv>      compile (and validate)
+ *     LevelCompiler --generate <rooms> <out>   grid map; .level writes text,
+ *                                              anything else binary
+ *     LevelCompiler --bench <level> [runs]     load time per form, and the
+ *                                              time to build every room
+ *
+ * Build together with the game sources except main.cpp and link
+ * sfml-graphics.
+ */
+
+#include "../Level.h"
+#include "../Room.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    const float ROOM_WIDTH = 800.0f;
+    const float ROOM_HEIGHT = 600.0f;
+    const int LOCK_EVERY = 5; // Every fifth room locks its east door behind a riddle
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Rooms on a square grid, doors to every neighbour, two guards per room
+    std::string generateText(int roomCount) {
+        int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(roomCount))));
+        std::ostringstream out;
+        out << "# Generated " << roomCount << "-room grid\nstart 1\n";
+
+        for (int id = 1; id <= roomCount; id++) {
+            out << "room " << id << " \"Gallery " << id << "\" 0 0 " << ROOM_WIDTH << " " << ROOM_HEIGHT
+                << " \"assets/room" << (id % 5 + 1) << ".png\"" << (id == roomCount ? " exit" : "") << "\n";
+        }
+
+        for (int id = 1; id <= roomCount; id++) {
+            int column = (id - 1) % columns;
+            bool locked = id % LOCK_EVERY == 0;
+            std::string key = "Gallery Key " + std::to_string(id);
+
+            if (column > 0) out << "door " << id << " 50 300 " << id - 1 << "\n";
+            if (column < columns - 1 && id < roomCount) {
+                out << "door " << id << " 750 300 " << id + 1;
+                if (locked) out << " locked \"" << key << "\"";
+                out << "\n";
+            }
+            if (id > columns) out << "door " << id << " 400 50 " << id - columns << "\n";
+            if (id + columns <= roomCount) out << "door " << id << " 400 550 " << id + columns << "\n";
+
+            out << "guard " << id << " 200 200 100 patrol 200 200 600 200 600 400 200 400\n";
+            out << "guard " << id << " 600 450 110 patrol 600 450 200 450\n";
+            out << "item " << id << " basic \"Exhibit " << id << "\" \"A museum piece\" 300 150\n";
+            if (locked) {
+                out << "puzzle " << id << " gate riddle \"What has keys but opens no locks?\" \"piano\"\n";
+                out << "item " << id << " key \"" << key << "\" \"" << key << "\" 650 500 reward gate\n";
+            }
+        }
+        return out.str();
+    }
+
+    bool readFile(const std::string& path, std::string& contents) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+        return true;
+    }
+
+    int compile(const std::string& input, const std::string& output) {
+        LevelData level;
+        if (!LevelLoader::loadText(input, level)) return EXIT_FAILURE;
+        if (!LevelLoader::saveBinary(level, output)) return EXIT_FAILURE;
+        std::cout << input << " -> " << output << ": " << level.rooms.size() << " rooms, " << level.doors.size()
+                  << " doors, " << level.guards.size() << " guards, " << level.items.size() << " items, "
+                  << level.puzzles.size() << " puzzles, " << level.obstacles.size() << " obstacles" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    int generate(int roomCount, const std::string& output) {
+        std::string text = generateText(roomCount);
+        if (endsWith(output, ".level")) {
+            std::ofstream file(output, std::ios::binary | std::ios::trunc);
+            if (!file || !(file << text)) {
+                std::cerr << "Error: Could not write " << output << std::endl;
+                return EXIT_FAILURE;
+            }
+            return EXIT_SUCCESS;
+        }
+
+        LevelData level;
+        std::string error;
+        if (!LevelLoader::parseText(text, level, error)) {
+            std::cerr << "Error: generated level, " << error << std::endl;
+            return EXIT_FAILURE;
+        }
+        return LevelLoader::saveBinary(level, output) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    template <typename Load>
+    double timeLoads(int runs, Load load) {
+        auto start = BenchClock::now();
+        for (int i = 0; i < runs; i++) {
+            if (!load()) return -1.0;
+        }
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count() / runs;
+    }
+
+    int bench(const std::string& path, int runs) {
+        // Bench both forms of the same level, whichever one was given
+        LevelData level;
+        if (!LevelLoader::load(path, level)) return EXIT_FAILURE;
+        std::string text;
+        bool haveText = readFile(path, text) && text.compare(0, 4, "MELV") != 0;
+        const std::string binaryPath = path + ".bench.melv";
+        if (!LevelLoader::saveBinary(level, binaryPath)) return EXIT_FAILURE;
+
+        std::cout << path << ": " << level.rooms.size() << " rooms, " << runs << " runs" << std::endl;
+        if (haveText) {
+            double textMs = timeLoads(runs, [&] {
+                LevelData loaded;
+                std::string error;
+                return LevelLoader::parseText(text, loaded, error);
+            });
+            std::cout << "  text parse:   " << textMs << " ms" << std::endl;
+        }
+        double binaryMs = timeLoads(runs, [&] {
+            LevelData loaded;
+            return LevelLoader::loadBinary(binaryPath, loaded);
+        });
+        std::cout << "  binary load:  " << binaryMs << " ms" << std::endl;
+
+        sf::Texture guardTexture;
+        std::map<int, std::shared_ptr<Room>> rooms;
+        auto start = BenchClock::now();
+        LevelLoader::build(level, guardTexture, rooms);
+        double buildMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+        std::cout << "  build rooms:  " << buildMs << " ms (" << rooms.size() << " rooms)" << std::endl;
+
+        std::remove(binaryPath.c_str());
+        return binaryMs >= 0.0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string first = argc > 1 ? argv[1] : "";
+    if (first == "--generate" && argc == 4) return generate(std::max(1, std::atoi(argv[2])), argv[3]);
+    if (first == "--bench" && argc >= 3) return bench(argv[2], argc > 3 ? std::max(1, std::atoi(argv[3])) : 20);
+    if (argc == 3 && first.compare(0, 2, "--") != 0) return compile(argv[1], argv[2]);
+
+    std::cerr << "Usage: LevelCompiler <in.level> <out.melv>" << std::endl
+              << "       LevelCompiler --generate <rooms> <out>" << std::endl
+              << "       LevelCompiler --bench <level> [runs]" << std::endl;
+    return EXIT_FAILURE;
+}
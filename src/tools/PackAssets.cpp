@@ -0,0 +1,23 @@
+/*
+ * Museum Escape - Asset Packing Tool
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Packs the assets directory into the single archive the game maps at
+ * startup. Run as a build step, after CookAssets:
+ *
+ *     PackAssets [assetsDir] [out]      (default: assets assets/assets.pak)
+ *
+ * Entries are named by their loose path, so run it from the directory the
+ * game runs in. Build together with ../AssetArchive.cpp and
+ * ../MappedFile.cpp and link sfml-graphics and sfml-audio.
+ */
+
+#include "../AssetArchive.h"
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string assetsDir = argc > 1 ? argv[1] : "assets";
+    std::string output = argc > 2 ? argv[2] : AssetArchive::DEFAULT_PATH;
+    return AssetArchive::pack(assetsDir, output) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,161 @@
+/*
+ * Museum Escape - Pathfinding Benchmark
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Times A* on an 800x600 room at the game's 10-pixel cell size (80x60
+ * cells) scattered with display cases, for random start/goal pairs:
+ * uncached searches, cache hits, and the time-sliced form the game runs
+ * (how many ticks the queue takes, and the slice times). Then the alarm's
+ * flow fields: the cost of one field, and of stepping every guard down it.
+ * The target is for the p99 of searches that find a path; failed searches
+ * (goals walled off by the cases) are reported on their own.
+ *
+ *     PathBench [paths] [obstacles]      (default 2000 40)
+ *
+ * Build together with ../PathService.cpp, ../NavGrid.cpp,
+ * ../FlowField.cpp and ../Profiler.cpp (header-only SFML use).
+ */
+
+#include "../NavGrid.h"
+#include "../PathService.h"
+#include "../FlowField.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    const sf::FloatRect ROOM({0.0f, 0.0f}, {800.0f, 600.0f});
+    const sf::Vector2f AGENT_SIZE(41.6f, 71.6f);
+    const double TARGET_MICROSECONDS = 50.0;
+
+    double microseconds(BenchClock::time_point start, BenchClock::time_point end) {
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    double percentile(std::vector<double> samples, double fraction) {
+        if (samples.empty()) return 0.0;
+        std::sort(samples.begin(), samples.end());
+        return samples[static_cast<std::size_t>(fraction * (samples.size() - 1))];
+    }
+
+    // Open positions only, so every pair is a real query
+    sf::Vector2f openPosition(const NavGrid& grid, std::mt19937& rng) {
+        std::uniform_real_distribution<float> x(0.0f, ROOM.size.x - AGENT_SIZE.x);
+        std::uniform_real_distribution<float> y(0.0f, ROOM.size.y - AGENT_SIZE.y);
+        for (;;) {
+            sf::Vector2f position(x(rng), y(rng));
+            if (!grid.isBlocked(grid.cellAt(position))) return position;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int pathCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    int obstacleCount = argc > 2 ? std::max(0, std::atoi(argv[2])) : 40;
+
+    std::mt19937 rng(224);
+    std::uniform_real_distribution<float> caseX(0.0f, 760.0f);
+    std::uniform_real_distribution<float> caseY(0.0f, 560.0f);
+    std::uniform_real_distribution<float> caseSize(20.0f, 60.0f);
+    std::vector<sf::FloatRect> obstacles;
+    for (int i = 0; i < obstacleCount; i++) obstacles.push_back({{caseX(rng), caseY(rng)}, {caseSize(rng), caseSize(rng)}});
+
+    NavGrid grid;
+    grid.build(ROOM, obstacles, AGENT_SIZE);
+    PathService paths;
+    paths.setGrid(&grid);
+
+    std::vector<std::pair<sf::Vector2f, sf::Vector2f>> pairs;
+    for (int i = 0; i < pathCount; i++) pairs.push_back({openPosition(grid, rng), openPosition(grid, rng)});
+
+    // Uncached: every search from scratch
+    std::vector<double> uncached, failed;
+    std::vector<sf::Vector2f> path;
+    std::size_t found = 0, waypoints = 0;
+    std::size_t expansionsBefore = paths.getTotalExpansions();
+    for (const auto& pair : pairs) {
+        paths.clearCache();
+        auto start = BenchClock::now();
+        bool ok = paths.findPath(pair.first, pair.second, path);
+        double elapsed = microseconds(start, BenchClock::now());
+        if (ok) {
+            uncached.push_back(elapsed);
+            found++;
+            waypoints += path.size();
+        } else {
+            failed.push_back(elapsed);
+        }
+    }
+    std::size_t expansions = paths.getTotalExpansions() - expansionsBefore;
+
+    // Cached: a patrol-sized working set of legs, repeated
+    std::vector<double> cached;
+    std::size_t working = std::min(pairs.size(), PathService::CACHE_CAPACITY);
+    for (std::size_t i = 0; i < working; i++) paths.findPath(pairs[i].first, pairs[i].second, path); // Fill
+    for (int round = 0; round < pathCount; round++) {
+        const auto& pair = pairs[round % working];
+        auto start = BenchClock::now();
+        paths.findPath(pair.first, pair.second, path);
+        cached.push_back(microseconds(start, BenchClock::now()));
+    }
+
+    // Time-sliced: all requests at once, one budgeted update per tick
+    paths.clearCache();
+    std::vector<PathService::Ticket> tickets;
+    for (const auto& pair : pairs) tickets.push_back(paths.request(pair.first, pair.second));
+    std::vector<double> slices;
+    int ticks = 0;
+    while (paths.getPendingCount() > 0) {
+        auto start = BenchClock::now();
+        paths.update();
+        slices.push_back(microseconds(start, BenchClock::now()));
+        ticks++;
+    }
+    for (PathService::Ticket ticket : tickets) paths.poll(ticket, path);
+
+    // Flow fields: one per goal, then one lookup per guard
+    std::vector<double> fieldBuilds;
+    FlowField field;
+    for (int i = 0; i < std::min(pathCount, 200); i++) {
+        auto start = BenchClock::now();
+        field.build(grid, grid.cellAt(pairs[i].second));
+        fieldBuilds.push_back(microseconds(start, BenchClock::now()));
+    }
+    const int guardCounts[] = {16, 1024};
+    double stepNanoseconds[2];
+    for (int g = 0; g < 2; g++) {
+        sf::Vector2f waypoint;
+        std::size_t steps = 0;
+        auto start = BenchClock::now();
+        for (int i = 0; i < guardCounts[g]; i++) steps += field.step(pairs[i % pairs.size()].first, waypoint);
+        stepNanoseconds[g] = microseconds(start, BenchClock::now()) * 1000.0 / guardCounts[g];
+        if (steps == 0) stepNanoseconds[g] = 0.0; // Keep the loop
+    }
+
+    double p99 = percentile(uncached, 0.99);
+    bool within = found > 0 && p99 < TARGET_MICROSECONDS;
+    std::cout << grid.getColumns() << "x" << grid.getRows() << " cells, " << obstacleCount << " obstacles, "
+              << pathCount << " paths (" << found << " found, "
+              << (found ? static_cast<double>(waypoints) / found : 0.0) << " waypoints each)" << std::endl;
+    std::cout << "  uncached:    p50 " << percentile(uncached, 0.5) << " us, p99 " << p99 << " us, max "
+              << percentile(uncached, 1.0) << " us, " << static_cast<double>(expansions) / pathCount
+              << " expansions per path" << std::endl;
+    if (!failed.empty()) {
+        std::cout << "  failed:      " << failed.size() << " searches, p50 " << percentile(failed, 0.5) << " us, max "
+                  << percentile(failed, 1.0) << " us" << std::endl;
+    }
+    std::cout << "  cached:      p50 " << percentile(cached, 0.5) << " us" << std::endl;
+    std::cout << "  time-sliced: " << ticks << " ticks at " << PathService::EXPANSIONS_PER_TICK
+              << " expansions, slice p99 " << percentile(slices, 0.99) << " us, max " << percentile(slices, 1.0) << " us" << std::endl;
+    std::cout << "  flow field:  build p50 " << percentile(fieldBuilds, 0.5) << " us; step "
+              << stepNanoseconds[0] << " ns per guard (" << guardCounts[0] << "), " << stepNanoseconds[1]
+              << " ns per guard (" << guardCounts[1] << ")" << std::endl;
+    std::cout << (within ? "Within" : "OVER") << " the " << TARGET_MICROSECONDS
+              << " us per path target (p99 of found paths)" << std::endl;
+    return within ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,305 @@
+/*
+ * Museum Escape - Stress Benchmark
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Builds a synthetic level at the requested scale and measures load time,
+ * memory, simulation tick time and off-screen render submission, written
+ * as JSON so runs from different builds can be diffed:
+ *
+ *     StressBench [--rooms N] [--guards N] [--items N] [--doors N]
+ *                 [--puzzles N] [--ticks N] [--frames N] [--out file.json]
+ *
+ * Defaults: 64 rooms, 16 guards, 32 items, 4 doors and 2 puzzles per room,
+ * 2000 ticks, 300 frames, JSON to stdout. Counts are per room. Rendering
+ * needs an OpenGL context; without one the render section is skipped.
+ *
+ * Build together with the game sources except main.cpp and link
+ * sfml-graphics.
+ */
+
+#include "../Level.h"
+#include "../Room.h"
+#include "../Guard.h"
+#include "../Player.h"
+#include "../HeadlessRunner.h"
+#include "../SpriteBatch.h"
+#include "../TextureAtlas.h"
+#include "../Profiler.h"
+#include "../AllocationCounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    const float ROOM_WIDTH = 800.0f;
+    const float ROOM_HEIGHT = 600.0f;
+    const float MARGIN = 60.0f;
+    const float TICK_STEP = 1.0f / 120.0f;
+    const unsigned int SEED = 1234;
+
+    struct Config {
+        int rooms = 64;
+        int guards = 16;
+        int items = 32;
+        int doors = 4;
+        int puzzles = 2;
+        int ticks = 2000;
+        int frames = 300;
+        std::string out;
+    };
+
+    struct Timings {
+        double mean = 0.0, p50 = 0.0, p99 = 0.0, max = 0.0; // Microseconds
+    };
+
+    struct Memory {
+        long long residentKb = -1; // -1: not available on this platform
+        long long peakKb = -1;
+    };
+
+    double elapsedMs(BenchClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    Timings summarize(std::vector<double> samples) {
+        Timings timings;
+        if (samples.empty()) return timings;
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (double sample : samples) total += sample;
+        auto percentile = [&](double p) {
+            std::size_t rank = static_cast<std::size_t>(std::ceil(p * samples.size()));
+            return samples[std::min(std::max<std::size_t>(rank, 1), samples.size()) - 1];
+        };
+        timings.mean = total / samples.size();
+        timings.p50 = percentile(0.50);
+        timings.p99 = percentile(0.99);
+        timings.max = samples.back();
+        return timings;
+    }
+
+    Memory sampleMemory() {
+        Memory memory;
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            memory.residentKb = static_cast<long long>(counters.WorkingSetSize / 1024);
+            memory.peakKb = static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+        }
+#elif defined(__linux__)
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmRSS:") == 0) memory.residentKb = std::atoll(line.c_str() + 6);
+            if (line.compare(0, 6, "VmHWM:") == 0) memory.peakKb = std::atoll(line.c_str() + 6);
+        }
+#endif
+        return memory;
+    }
+
+    // Identical rooms. Door k of a room leads k+1 rooms further on,
+    // wrapping, so every room is reachable; the last room is the exit.
+    std::string generateText(const Config& config) {
+        std::mt19937 rng(SEED);
+        std::uniform_real_distribution<float> randomX(MARGIN, ROOM_WIDTH - MARGIN);
+        std::uniform_real_distribution<float> randomY(MARGIN, ROOM_HEIGHT - MARGIN);
+        std::uniform_real_distribution<float> randomRadius(80.0f, 120.0f);
+
+        std::ostringstream out;
+        out << "# Stress level: " << config.rooms << " rooms\nstart 1\n";
+        for (int id = 1; id <= config.rooms; id++) {
+            out << "room " << id << " \"Hall " << id << "\" 0 0 " << ROOM_WIDTH << " " << ROOM_HEIGHT << " \"\""
+                << (id == config.rooms ? " exit" : "") << "\n";
+        }
+        for (int id = 1; id <= config.rooms; id++) {
+            for (int d = 0; d < config.doors; d++) {
+                int target = (id - 1 + d + 1) % config.rooms + 1;
+                float x = MARGIN + (ROOM_WIDTH - 2.0f * MARGIN) * (d + 1) / (config.doors + 1);
+                out << "door " << id << " " << x << " " << MARGIN / 2.0f << " " << target << "\n";
+            }
+            for (int g = 0; g < config.guards; g++) {
+                out << "guard " << id << " " << randomX(rng) << " " << randomY(rng) << " " << randomRadius(rng) << " patrol";
+                for (int p = 0; p < 4; p++) out << " " << randomX(rng) << " " << randomY(rng);
+                out << "\n";
+            }
+            for (int i = 0; i < config.items; i++) {
+                out << "item " << id << " basic \"Exhibit " << id << "-" << i << "\" \"A museum piece\" "
+                    << randomX(rng) << " " << randomY(rng) << "\n";
+            }
+            for (int p = 0; p < config.puzzles; p++) {
+                out << "puzzle " << id << " p" << p << " lock \"" << 1000 + (id * 7 + p) % 9000 << "\"\n";
+            }
+        }
+        return out.str();
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            int number = std::max(0, std::atoi(value.c_str()));
+            if (arg == "--rooms") config.rooms = std::max(1, number);
+            else if (arg == "--guards") config.guards = number;
+            else if (arg == "--items") config.items = number;
+            else if (arg == "--doors") config.doors = number;
+            else if (arg == "--puzzles") config.puzzles = number;
+            else if (arg == "--ticks") config.ticks = number;
+            else if (arg == "--frames") config.frames = number;
+            else if (arg == "--out") config.out = value;
+            else return false;
+        }
+        return true;
+    }
+
+    void writeTimings(std::ostream& out, const char* name, const Timings& timings) {
+        out << "\"" << name << "\": {\"mean_us\": " << timings.mean << ", \"p50_us\": " << timings.p50
+            << ", \"p99_us\": " << timings.p99 << ", \"max_us\": " << timings.max << "}";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parseArguments(argc, argv, config)) {
+        std::cerr << "Usage: StressBench [--rooms N] [--guards N] [--items N] [--doors N]" << std::endl
+                  << "                   [--puzzles N] [--ticks N] [--frames N] [--out file.json]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    Memory baseline = sampleMemory();
+
+    // ---- Load: text parse, binary round trip, building every room ----
+    std::string text = generateText(config);
+    LevelData level;
+    std::string error;
+    auto start = BenchClock::now();
+    if (!LevelLoader::parseText(text, level, error)) {
+        std::cerr << "Error: generated level, " << error << std::endl;
+        return EXIT_FAILURE;
+    }
+    double parseMs = elapsedMs(start);
+
+    const std::string binaryPath = "stress_bench.melv";
+    if (!LevelLoader::saveBinary(level, binaryPath)) return EXIT_FAILURE;
+    LevelData loaded;
+    start = BenchClock::now();
+    if (!LevelLoader::loadBinary(binaryPath, loaded)) return EXIT_FAILURE;
+    double binaryMs = elapsedMs(start);
+
+    // Stand-in character art, packed into an atlas the way Game does it
+    sf::Image playerImage({40, 40}, sf::Color::Green);
+    sf::Image guardImage({40, 40}, sf::Color::Red);
+    sf::Texture playerTexture, guardTexture;
+    bool haveTextures = playerTexture.loadFromImage(playerImage) && guardTexture.loadFromImage(guardImage);
+
+    std::map<int, std::shared_ptr<Room>> rooms;
+    start = BenchClock::now();
+    LevelLoader::build(loaded, guardTexture, rooms);
+    double buildMs = elapsedMs(start);
+    Memory built = sampleMemory();
+
+    // ---- Simulation: every room's guards and puzzles each tick ----
+    std::vector<double> worldTicks;
+    worldTicks.reserve(config.ticks);
+    for (int t = 0; t < config.ticks; t++) {
+        auto tickStart = BenchClock::now();
+        for (auto& pair : rooms) {
+            pair.second->update(TICK_STEP);
+            pair.second->updateGuards(TICK_STEP);
+        }
+        worldTicks.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - tickStart).count());
+    }
+
+    // ...and the full game tick (input, collisions, detection) in one room
+    HeadlessRunner runner(1.0f / TICK_STEP, SEED);
+    unsigned long long simTicksRun = 0;
+    double simTickUs = 0.0;
+    if (runner.getSimulation().loadLevel(binaryPath)) {
+        HeadlessRunner::Report report = runner.run(static_cast<unsigned long long>(config.ticks));
+        simTicksRun = report.ticks;
+        simTickUs = report.ticks > 0 ? report.seconds * 1e6 / report.ticks : 0.0;
+    }
+    std::remove(binaryPath.c_str());
+
+    // ---- Rendering: CPU time to submit each room off-screen ----
+    std::vector<double> frameTimes;
+    std::size_t vertices = 0;
+    std::uint64_t steadyAllocations = 0; // After every room has been drawn once
+    sf::RenderTexture target;
+    bool canRender = haveTextures && target.resize({static_cast<unsigned int>(ROOM_WIDTH), static_cast<unsigned int>(ROOM_HEIGHT)});
+    if (canRender) {
+        TextureAtlas atlas;
+        atlas.add(playerTexture, playerImage);
+        atlas.add(guardTexture, guardImage);
+        SpriteBatch batch;
+        if (atlas.build()) batch.setAtlas(&atlas);
+        Player player(ROOM_WIDTH / 2.0f, ROOM_HEIGHT / 2.0f, playerTexture);
+
+        auto room = rooms.begin();
+        frameTimes.reserve(config.frames);
+        for (int f = 0; f < config.frames; f++, ++room) {
+            if (room == rooms.end()) room = rooms.begin();
+            std::uint64_t allocationsBefore = AllocationCounter::getCount();
+            auto frameStart = BenchClock::now();
+            target.clear(sf::Color(20, 20, 30));
+            batch.clear();
+            room->second->draw(target, batch);
+            player.draw(batch);
+            target.draw(batch);
+            target.display();
+            frameTimes.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - frameStart).count());
+            vertices = std::max(vertices, batch.getVertexCount());
+            if (f >= static_cast<int>(rooms.size())) steadyAllocations += AllocationCounter::getCount() - allocationsBefore;
+        }
+    }
+    Memory finished = sampleMemory();
+
+    // ---- Report ----
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"config\": {\"rooms\": " << config.rooms << ", \"guards_per_room\": " << config.guards
+         << ", \"items_per_room\": " << config.items << ", \"doors_per_room\": " << config.doors
+         << ", \"puzzles_per_room\": " << config.puzzles << ", \"ticks\": " << config.ticks
+         << ", \"frames\": " << config.frames << ", \"profiler\": " << (PROFILER_ENABLED ? "true" : "false") << "},\n";
+    json << "  \"load\": {\"text_bytes\": " << text.size() << ", \"parse_ms\": " << parseMs
+         << ", \"binary_load_ms\": " << binaryMs << ", \"build_rooms_ms\": " << buildMs << "},\n";
+    json << "  \"memory\": {\"baseline_kb\": " << baseline.residentKb << ", \"after_build_kb\": " << built.residentKb
+         << ", \"after_run_kb\": " << finished.residentKb << ", \"peak_kb\": " << finished.peakKb << "},\n";
+    json << "  \"tick\": {";
+    writeTimings(json, "world", summarize(worldTicks));
+    json << ", \"game_mean_us\": " << simTickUs << ", \"game_ticks\": " << simTicksRun << "},\n";
+    json << "  \"render\": {\"available\": " << (canRender ? "true" : "false") << ", ";
+    writeTimings(json, "submit", summarize(frameTimes));
+    json << ", \"max_vertices\": " << vertices << ", \"steady_allocations\": ";
+    if (AllocationCounter::isEnabled()) json << steadyAllocations;
+    else json << "null";
+    json << "}\n";
+    json << "}\n";
+
+    if (config.out.empty()) {
+        std::cout << json.str();
+        return EXIT_SUCCESS;
+    }
+    std::ofstream file(config.out, std::ios::binary | std::ios::trunc);
+    if (!file || !(file << json.str())) {
+        std::cerr << "Error: Could not write " << config.out << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
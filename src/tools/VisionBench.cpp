@@ -0,0 +1,108 @@
+/*
+ * Museum Escape - Vision Cone Benchmark
+ * CS/CE 224/272 - Fall 2025
+ *
+ * Times guard detection with vision cones and occlusion: a crowd of
+ * patrolling guards in a large walled room checks a player walking a loop
+ * 60 times a second, once with the per-guard raycast cache and once
+ * raycasting every candidate:
+ *
+ *     VisionBench [guards] [seconds]      (default 1000 10)
+ *
+ * Build together with ../GuardSystem.cpp, ../PathService.cpp,
+ * ../NavGrid.cpp, ../FlowField.cpp and ../Profiler.cpp (header-only SFML
+ * use).
+ */
+
+#include "../GuardSystem.h"
+#include "../NavGrid.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    const sf::FloatRect ROOM({0.0f, 0.0f}, {1600.0f, 1200.0f});
+    const sf::Vector2f EYE_OFFSET(20.8f, 35.8f); // Half the character size
+    const int WALL_COUNT = 80;
+    const float CHECK_STEP = 1.0f / 60.0f;
+
+    struct Result {
+        double microsecondsPerCheck;
+        double raycastsPerCheck;
+        std::size_t detections;
+    };
+
+    // Short wall pieces, half of them horizontal
+    std::vector<sf::FloatRect> makeWalls(std::mt19937& rng) {
+        std::uniform_real_distribution<float> x(0.0f, ROOM.size.x - 80.0f);
+        std::uniform_real_distribution<float> y(0.0f, ROOM.size.y - 80.0f);
+        std::vector<sf::FloatRect> walls;
+        for (int i = 0; i < WALL_COUNT; i++) {
+            sf::Vector2f size = i % 2 ? sf::Vector2f(80.0f, 10.0f) : sf::Vector2f(10.0f, 80.0f);
+            walls.push_back({{x(rng), y(rng)}, size});
+        }
+        return walls;
+    }
+
+    void populate(GuardSystem& guards, std::size_t count) {
+        std::mt19937 rng(272);
+        std::uniform_real_distribution<float> x(0.0f, ROOM.size.x);
+        std::uniform_real_distribution<float> y(0.0f, ROOM.size.y);
+        std::uniform_real_distribution<float> radius(150.0f, 250.0f);
+        for (std::size_t i = 0; i < count; i++) {
+            std::size_t slot = guards.add({x(rng), y(rng)}, 80.0f, radius(rng), 0.0f); // No cooldown: every check counts
+            guards.setPatrol(slot, {{x(rng), y(rng)}, {x(rng), y(rng)}});
+        }
+    }
+
+    Result run(const NavGrid& walls, std::size_t count, int checks, bool caching) {
+        GuardSystem guards;
+        populate(guards, count);
+        guards.setOccluders(&walls, EYE_OFFSET);
+        guards.setSightCaching(caching);
+
+        std::vector<std::size_t> hits;
+        Result result{0.0, 0.0, 0};
+        double total = 0.0;
+        for (int check = 0; check < checks; check++) {
+            // The player walks a wide loop around the middle of the room
+            float angle = check * 0.01f;
+            sf::Vector2f player(800.0f + 500.0f * std::cos(angle), 600.0f + 400.0f * std::sin(angle));
+
+            guards.savePreviousPositions();
+            guards.update(CHECK_STEP);
+            auto start = BenchClock::now();
+            guards.detect(player, hits);
+            total += std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+            result.detections += hits.size();
+        }
+        result.microsecondsPerCheck = total / checks;
+        result.raycastsPerCheck = static_cast<double>(guards.getRaycastCount()) / checks;
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    int seconds = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+    int checks = seconds * 60;
+
+    std::mt19937 rng(224);
+    NavGrid walls;
+    walls.build(ROOM, makeWalls(rng), {0.0f, 0.0f});
+
+    std::cout << count << " guards, " << WALL_COUNT << " walls, " << checks << " checks at 60 Hz" << std::endl;
+    const bool modes[] = {true, false};
+    for (bool caching : modes) {
+        Result result = run(walls, count, checks, caching);
+        std::cout << (caching ? "  cached:   " : "  uncached: ") << result.microsecondsPerCheck << " us per check, "
+                  << result.raycastsPerCheck << " raycasts per check, " << result.detections << " detections"
+                  << std::endl;
+    }
+    return EXIT_SUCCESS;
+}